@@ -250,18 +250,18 @@ typedef struct sParenInfo {
 *   DATA DEFINITIONS
 */
 
-static jmp_buf Exception;
+static CTAGS_THREAD_LOCAL jmp_buf Exception;
 
 static langType Lang_c;
 static langType Lang_cpp;
 static langType Lang_csharp;
 static langType Lang_java;
 static langType Lang_vera;
-static vString *Signature;
-static boolean CollectingSignature;
+static CTAGS_THREAD_LOCAL vString *Signature;
+static CTAGS_THREAD_LOCAL boolean CollectingSignature;
 
 /* Number used to uniquely identify anonymous structs and unions. */
-static int AnonymousID = 0;
+static CTAGS_THREAD_LOCAL int AnonymousID = 0;
 
 /* Used to index into the CKinds table. */
 typedef enum {
@@ -2556,7 +2556,7 @@ static void nextToken (statementInfo *const st)
 *   Scanning support functions
 */
 
-static statementInfo *CurrentStatement = NULL;
+static CTAGS_THREAD_LOCAL statementInfo *CurrentStatement = NULL;
 
 static statementInfo *newStatement (statementInfo *const parent)
 {
@@ -2801,6 +2801,7 @@ static boolean findCTags (const unsigned int passCount)
     Assert (passCount < 3);
     cppInit ((boolean) (passCount > 1), isLanguage (Lang_csharp));
     Signature = vStringNew ();
+    AnonymousID = 0;  /* anonymous names only depend on the file, whichever thread parses it */
 
     exception = (exception_t) setjmp (Exception);
     retry = FALSE;
@@ -145,7 +145,7 @@ static kindOption EiffelKinds [] = {
 
 #endif
 
-static jmp_buf Exception;
+static CTAGS_THREAD_LOCAL jmp_buf Exception;
 
 static const keywordDesc EiffelKeywordTable [] = {
     /* keyword          keyword ID */
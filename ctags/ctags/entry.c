@@ -51,9 +51,9 @@
 /* When scaning, items adding to the single-linked list. 
    Here is pointers on it
 */
-TagEntryListItem* firstTagEntry = NULL;  /*pointer to the first entry in the list
+CTAGS_THREAD_LOCAL TagEntryListItem* firstTagEntry = NULL;  /*pointer to the first entry in the list
                                             for return it as result of parsing file */
-TagEntryListItem* lastTagEntry = NULL;   //for adding entryes
+CTAGS_THREAD_LOCAL TagEntryListItem* lastTagEntry = NULL;   //for adding entryes
 
 
 #if 0 /* Library mode */
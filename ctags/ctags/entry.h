@@ -85,8 +85,8 @@ typedef struct  sTagEntryListItem {
 } TagEntryListItem ; 
 
 //  Global pointers to entrys in the list
-extern TagEntryListItem * firstTagEntry ;  //for return it as result
-extern TagEntryListItem * lastTagEntry ;   //for adding entryes
+extern CTAGS_THREAD_LOCAL TagEntryListItem * firstTagEntry ;  //for return it as result
+extern CTAGS_THREAD_LOCAL TagEntryListItem * lastTagEntry ;   //for adding entryes
 
 /*
 *   FUNCTION PROTOTYPES
@@ -3,6 +3,7 @@
 #include "string.h"
 #include "read.h"
 #include "entry.h"
+#include "routines.h"
 
 extern parserDefinition** LanguageTable;
 
@@ -17,33 +18,61 @@ extern void deInitCtags()
     freeParserResources();
 }
 
-extern TagEntryListItem* createTagEntryListItem( const char* fileName, const char* langName )
+extern void freeCtagsThreadResources()
+{
+    freeSourceFileResources();
+    freeStatCache();
+}
+
+static langType tagEntryListItemLanguage( const char* fileName, const char* langName )
 {
-    const parserDefinition* language;
-    langType lang; 
+    if ( ( langName != NULL ) && ( strlen( langName ) != 0 ) )
+    {
+        return getNamedLanguage( langName );
+    }
+    
+    return getFileLanguage( fileName );
+}
+
+static TagEntryListItem* parseTagEntryListItem( langType lang )
+{
+    const parserDefinition* language = LanguageTable[ lang ];
     unsigned int passCount;
     boolean retried;
-
-    firstTagEntry = NULL; // generate new list
     
-    if ( ( langName != NULL ) && ( strlen( langName ) != 0 ) )
+    passCount = 0;
+    retried = FALSE;
+    
+    if ( language->parser != NULL )
     {
-        lang = getNamedLanguage( langName );
+        language->parser();
     }
-    else
+    else if ( language->parser2 != NULL )
     {
-        lang = getFileLanguage( fileName );
+        do
+        {
+            retried = language->parser2( ++passCount );
+        } while ( retried );
     }
     
+    return firstTagEntry;
+}
+
+extern TagEntryListItem* createTagEntryListItem( const char* fileName, const char* langName )
+{
+    langType lang;
+
+    firstTagEntry = NULL; // generate new list
+    
+    lang = tagEntryListItemLanguage( fileName, langName );
+    
     if ( lang <= 0 )
     {
         //printf( "Will not parse %s\n",fileName );
         return NULL;
     }
     
-    language = LanguageTable[ lang ];
-    
-    if ( language == NULL )
+    if ( LanguageTable[ lang ] == NULL )
     {
         return NULL;
     }
@@ -53,22 +82,34 @@ extern TagEntryListItem* createTagEntryListItem( const char* fileName, const cha
         return NULL;
     }
     
-    passCount = 0;
-    retried = FALSE;
+    return parseTagEntryListItem( lang );
+}
+
+extern TagEntryListItem* createBufferTagEntryListItem( const char* fileName, const char* buffer, size_t size, const char* langName )
+{
+    langType lang;
+
+    firstTagEntry = NULL; // generate new list
     
-    if ( language->parser != NULL )
+    lang = tagEntryListItemLanguage( fileName, langName );
+    
+    if ( lang <= 0 )
     {
-        language->parser();
+        return NULL;
     }
-    else if ( language->parser2 != NULL )
+    
+    if ( LanguageTable[ lang ] == NULL )
     {
-        do
-        {
-            retried = language->parser2( ++passCount );
-        } while ( retried );
+        return NULL;
     }
     
-    return firstTagEntry;
+    // the buffer is read in place, tags are named after fileName
+    if ( !bufferOpen( fileName, (const unsigned char*)buffer, size, lang ) )
+    {
+        return NULL;
+    }
+    
+    return parseTagEntryListItem( lang );
 }
 
 extern void freeTagEntryListItem( TagEntryListItem* item )
@@ -9,7 +9,11 @@
 
 extern void initCtags();
 extern void deInitCtags();
+/*free the parsing state of the calling thread, to call before a thread that parsed files exits
+*/
+extern void freeCtagsThreadResources();
 extern TagEntryListItem* createTagEntryListItem( const char* fileName, const char* langName );
+extern TagEntryListItem* createBufferTagEntryListItem( const char* fileName, const char* buffer, size_t size, const char* langName );
 extern void freeTagEntryListItem( TagEntryListItem* item );
 extern void setLanguageTypeKinds( const langType language, const char* kinds );
 extern void setLanguageKinds( const char* const language, const char* kinds );
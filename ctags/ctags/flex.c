@@ -49,8 +49,8 @@ typedef enum eException { ExceptionNone, ExceptionEOF } exception_t;
 /*
  * Tracks class and function names already created
  */
-static stringList *ClassNames;
-static stringList *FunctionNames;
+static CTAGS_THREAD_LOCAL stringList *ClassNames;
+static CTAGS_THREAD_LOCAL stringList *FunctionNames;
 
 /*  Used to specify type of keyword.
 */
@@ -137,7 +137,7 @@ typedef struct sTokenInfo {
 
 static langType Lang_js;
 
-static jmp_buf Exception;
+static CTAGS_THREAD_LOCAL jmp_buf Exception;
 
 typedef enum {
     FLEXTAG_FUNCTION,
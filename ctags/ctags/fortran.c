@@ -191,12 +191,12 @@ typedef struct sTokenInfo {
 */
 
 static langType Lang_fortran;
-static jmp_buf Exception;
-static int Ungetc;
-static unsigned int Column;
-static boolean FreeSourceForm;
-static boolean ParsingString;
-static tokenInfo *Parent;
+static CTAGS_THREAD_LOCAL jmp_buf Exception;
+static CTAGS_THREAD_LOCAL int Ungetc;
+static CTAGS_THREAD_LOCAL unsigned int Column;
+static CTAGS_THREAD_LOCAL boolean FreeSourceForm;
+static CTAGS_THREAD_LOCAL boolean ParsingString;
+static CTAGS_THREAD_LOCAL tokenInfo *Parent;
 
 /* indexed by tagType */
 static kindOption FortranKinds [] = {
@@ -296,7 +296,7 @@ static const keywordDesc FortranKeywordTable [] = {
     { "while",          KEYWORD_while        }
 };
 
-static struct {
+static CTAGS_THREAD_LOCAL struct {
     unsigned int count;
     unsigned int max;
     tokenInfo* list;
@@ -693,7 +693,7 @@ static int skipToNextLine (void)
 
 static int getFreeFormChar (void)
 {
-    static boolean newline = TRUE;
+    static CTAGS_THREAD_LOCAL boolean newline = TRUE;
     boolean advanceLine = FALSE;
     int c = fileGetc ();
 
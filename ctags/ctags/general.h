@@ -64,6 +64,19 @@
 # define __printf__(s,f)
 #endif
 
+/*  The state of a parse is kept per thread so several files can be parsed
+ *  at the same time, CTAGS_REENTRANT tells the library users it is the case.
+ */
+#if defined (__GNUC__)
+# define CTAGS_THREAD_LOCAL  __thread
+# define CTAGS_REENTRANT 1
+#elif defined (_MSC_VER)
+# define CTAGS_THREAD_LOCAL  __declspec(thread)
+# define CTAGS_REENTRANT 1
+#else
+# define CTAGS_THREAD_LOCAL
+#endif
+
 /*
  *  Portability macros
  */
@@ -494,26 +494,26 @@ typedef void (*parseNext) (vString * const ident, ocaToken what);
 /********** Helpers */
 /* This variable hold the 'parser' which is going to
  * handle the next token */
-parseNext toDoNext;
+CTAGS_THREAD_LOCAL parseNext toDoNext;
 
 /* Special variable used by parser eater to
  * determine which action to put after their
  * job is finished. */
-parseNext comeAfter;
+CTAGS_THREAD_LOCAL parseNext comeAfter;
 
 /* If a token put an end to current delcaration/
  * statement */
-ocaToken terminatingToken;
+CTAGS_THREAD_LOCAL ocaToken terminatingToken;
 
 /* Token to be searched by the different
  * parser eater. */
-ocaToken waitedToken;
+CTAGS_THREAD_LOCAL ocaToken waitedToken;
 
 /* name of the last class, used for
  * context stacking. */
-vString *lastClass;
+CTAGS_THREAD_LOCAL vString *lastClass;
 
-vString *voidName;
+CTAGS_THREAD_LOCAL vString *voidName;
 
 typedef enum _sContextKind {
     ContextStrong,
@@ -539,9 +539,9 @@ typedef struct _sOcamlContext {
 
 /* context stack, can be used to output scope information
  * into the tag file. */
-ocamlContext stack[OCAML_MAX_STACK_SIZE];
+CTAGS_THREAD_LOCAL ocamlContext stack[OCAML_MAX_STACK_SIZE];
 /* current position in the tag */
-int stackIndex;
+CTAGS_THREAD_LOCAL int stackIndex;
 
 /* special function, often recalled, so putting it here */
 static void globalScope (vString * const ident, ocaToken what);
@@ -748,9 +748,9 @@ static void tillToken (vString * const UNUSED (ident), ocaToken what)
  * take care of balanced parentheses/bracket use */
 static void contextualTillToken (vString * const UNUSED (ident), ocaToken what)
 {
-    static int parentheses = 0;
-    static int bracket = 0;
-    static int curly = 0;
+    static CTAGS_THREAD_LOCAL int parentheses = 0;
+    static CTAGS_THREAD_LOCAL int bracket = 0;
+    static CTAGS_THREAD_LOCAL int curly = 0;
 
     switch (what)
     {
@@ -885,7 +885,7 @@ static void addTag (vString * const ident, int kind)
     makeTagEntry (&toCreate);
 }
 
-boolean needStrongPoping = FALSE;
+CTAGS_THREAD_LOCAL boolean needStrongPoping = FALSE;
 static void requestStrongPoping ( void )
 {
     needStrongPoping = TRUE;
@@ -954,8 +954,8 @@ static void exceptionDecl (vString * const ident, ocaToken what)
     toDoNext = &globalScope;
 }
 
-tagEntryInfo tempTag;
-vString *tempIdent;
+CTAGS_THREAD_LOCAL tagEntryInfo tempTag;
+CTAGS_THREAD_LOCAL vString *tempIdent;
 
 /* Ensure a constructor is not a type path beginning
  * with a module */
@@ -1088,13 +1088,13 @@ static void typeSpecification (vString * const ident, ocaToken what)
 }
 
 
-static boolean dirtySpecialParam = FALSE;
+static CTAGS_THREAD_LOCAL boolean dirtySpecialParam = FALSE;
 
 
 /* parse the ~label and ~label:type parameter */
 static void parseLabel (vString * const ident, ocaToken what)
 {
-    static int parCount = 0;
+    static CTAGS_THREAD_LOCAL int parCount = 0;
 
     switch (what)
     {
@@ -1147,7 +1147,7 @@ static void parseLabel (vString * const ident, ocaToken what)
  * ?(foo = value) */
 static void parseOptionnal (vString * const ident, ocaToken what)
 {
-    static int parCount = 0;
+    static CTAGS_THREAD_LOCAL int parCount = 0;
 
 
     switch (what)
@@ -1423,7 +1423,7 @@ static void methodDecl (vString * const ident, ocaToken what)
 
 /* name of the last module, used for
  * context stacking. */
-vString *lastModule;
+CTAGS_THREAD_LOCAL vString *lastModule;
 
 
 /* parse
@@ -1566,7 +1566,7 @@ static void globalScope (vString * const UNUSED (ident), ocaToken what)
 {
     /* Do not touch, this is used only by the global scope
      * to handle an 'and' */
-    static parseNext previousParser = NULL;
+    static CTAGS_THREAD_LOCAL parseNext previousParser = NULL;
 
     switch (what)
     {
@@ -57,7 +57,7 @@ static void makePascalTag (const tagEntryInfo* const tag)
         makeTagEntry (tag);
 }
 
-static const unsigned char* dbp;
+static CTAGS_THREAD_LOCAL const unsigned char* dbp;
 
 #define starttoken(c) (isalpha ((int) c) || (int) c == '_')
 #define intoken(c)    (isalnum ((int) c) || (int) c == '_' || (int) c == '.')
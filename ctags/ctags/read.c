@@ -29,8 +29,9 @@
 /*
 *   DATA DEFINITIONS
 */
-inputFile File;  /* globally read through macros */
-static fpos_t StartOfLine;  /* holds deferred position of start of line */
+CTAGS_THREAD_LOCAL inputFile File;  /* globally read through macros, one per parsing thread */
+static CTAGS_THREAD_LOCAL fpos_t StartOfLine;  /* holds deferred position of start of line */
+static CTAGS_THREAD_LOCAL size_t BufferStartOfLine;  /* same as StartOfLine for memory buffers */
 
 /*
 *   FUNCTION DEFINITIONS
@@ -38,16 +39,22 @@ static fpos_t StartOfLine;  /* holds deferred position of start of line */
 
 extern void freeSourceFileResources (void)
 {
+    /* the next file parsed by this thread must not see the freed strings */
     if (File.name != NULL)
         vStringDelete (File.name);
+    File.name = NULL;
     if (File.path != NULL)
         vStringDelete (File.path);
+    File.path = NULL;
     if (File.source.name != NULL)
         vStringDelete (File.source.name);
+    File.source.name = NULL;
     if (File.source.tagPath != NULL)
         eFree (File.source.tagPath);
+    File.source.tagPath = NULL;
     if (File.line != NULL)
         vStringDelete (File.line);
+    File.line = NULL;
 }
 
 /*
@@ -115,6 +122,44 @@ static boolean setSourceFileName (vString *const fileName)
     return result;
 }
 
+/*
+ *   Input stream access, reading either the file stream or the memory buffer
+ */
+
+static int inputGetc (void)
+{
+    if (File.buffer == NULL)
+        return getc (File.fp);
+    else if (File.bufferPosition < File.bufferSize)
+        return File.buffer [File.bufferPosition++];
+    else
+        return EOF;
+}
+
+static void inputUngetc (int c)
+{
+    if (File.buffer == NULL)
+        ungetc (c, File.fp);
+    else if (c != EOF  &&  File.bufferPosition > 0)
+        --File.bufferPosition;
+}
+
+static void inputMarkStartOfLine (void)
+{
+    if (File.buffer == NULL)
+        fgetpos (File.fp, &StartOfLine);
+    else
+        BufferStartOfLine = File.bufferPosition;
+}
+
+static void inputRewindToStartOfLine (void)
+{
+    if (File.buffer == NULL)
+        fsetpos (File.fp, &StartOfLine);
+    else
+        File.bufferPosition = BufferStartOfLine;
+}
+
 /*
  *   Line directive parsing
  */
@@ -123,7 +168,7 @@ static int skipWhite (void)
 {
     int c;
     do
-        c = getc (File.fp);
+        c = inputGetc ();
     while (c == ' '  ||  c == '\t');
     return c;
 }
@@ -135,9 +180,9 @@ static unsigned long readLineNumber (void)
     while (c != EOF  &&  isdigit (c))
     {
         lNum = (lNum * 10) + (c - '0');
-        c = getc (File.fp);
+        c = inputGetc ();
     }
-    ungetc (c, File.fp);
+    inputUngetc (c);
     if (c != ' '  &&  c != '\t')
         lNum = 0;
 
@@ -160,17 +205,17 @@ static vString *readFileName (void)
 
     if (c == '"')
     {
-        c = getc (File.fp);  /* skip double-quote */
+        c = inputGetc ();  /* skip double-quote */
         quoteDelimited = TRUE;
     }
     while (c != EOF  &&  c != '\n'  &&
             (quoteDelimited ? (c != '"') : (c != ' '  &&  c != '\t')))
     {
         vStringPut (fileName, c);
-        c = getc (File.fp);
+        c = inputGetc ();
     }
     if (c == '\n')
-        ungetc (c, File.fp);
+        inputUngetc (c);
     vStringPut (fileName, '\0');
 
     return fileName;
@@ -184,13 +229,13 @@ static boolean parseLineDirective (void)
 
     if (isdigit (c))
     {
-        ungetc (c, File.fp);
+        inputUngetc (c);
         result = TRUE;
     }
-    else if (c == 'l'  &&  getc (File.fp) == 'i'  &&
-             getc (File.fp) == 'n'  &&  getc (File.fp) == 'e')
+    else if (c == 'l'  &&  inputGetc () == 'i'  &&
+             inputGetc () == 'n'  &&  inputGetc () == 'e')
     {
-        c = getc (File.fp);
+        c = inputGetc ();
         if (c == ' '  ||  c == '\t')
         {
             DebugStatement ( lineStr = "line"; )
@@ -242,6 +287,28 @@ static boolean parseLineDirective (void)
  *   Source file I/O operations
  */
 
+/*  Resets the reading state once the source file or buffer is opened.
+ */
+static void fileInitialize (const char *const fileName, const langType language)
+{
+    setInputFileName (fileName);
+    File.currentLine  = NULL;
+    File.language     = language;
+    File.lineNumber   = 0L;
+    File.eof          = FALSE;
+    File.newLine      = TRUE;
+
+    if (File.line != NULL)
+        vStringClear (File.line);
+
+    setSourceFileParameters (vStringNewInit (fileName));
+    File.source.lineNumber = 0L;
+
+    verbose ("OPENING %s as %s language %sfile\n", fileName,
+            getLanguageName (language),
+            File.source.isHeader ? "include " : "");
+}
+
 /*  This function opens a source file, and resets the line counter.  If it
  *  fails, it will display an error message and leave the File.fp set to NULL.
  */
@@ -261,6 +328,7 @@ extern boolean fileOpen (const char *const fileName, const langType language)
         fclose (File.fp);  /* close any open source file */
         File.fp = NULL;
     }
+    File.buffer = NULL;
 
     File.fp = fopen (fileName, openMode);
     if (File.fp == NULL)
@@ -269,26 +337,36 @@ extern boolean fileOpen (const char *const fileName, const langType language)
     {
         opened = TRUE;
 
-        setInputFileName (fileName);
         fgetpos (File.fp, &StartOfLine);
         fgetpos (File.fp, &File.filePosition);
-        File.currentLine  = NULL;
-        File.language     = language;
-        File.lineNumber   = 0L;
-        File.eof          = FALSE;
-        File.newLine      = TRUE;
+        fileInitialize (fileName, language);
+    }
+    return opened;
+}
 
-        if (File.line != NULL)
-            vStringClear (File.line);
+/*  This function uses a memory buffer as the content of the source file
+ *  "fileName", and resets the line counter. The buffer is not copied and must
+ *  stay valid until the parsing is done. File positions are not available for
+ *  buffers, so readSourceLine () can not be used on tags made from them.
+ */
+extern boolean bufferOpen (const char *const fileName,
+        const unsigned char *const buffer, const size_t size,
+        const langType language)
+{
+    if (File.fp != NULL)
+    {
+        fclose (File.fp);  /* close any open source file */
+        File.fp = NULL;
+    }
 
-        setSourceFileParameters (vStringNewInit (fileName));
-        File.source.lineNumber = 0L;
+    File.buffer = buffer;
+    File.bufferSize = size;
+    File.bufferPosition = 0;
+    BufferStartOfLine = 0;
+    memset (&File.filePosition, 0, sizeof (File.filePosition));
+    fileInitialize (fileName, language);
 
-        verbose ("OPENING %s as %s language %sfile\n", fileName,
-                getLanguageName (language),
-                File.source.isHeader ? "include " : "");
-    }
-    return opened;
+    return TRUE;
 }
 
 #if 0
@@ -334,7 +412,7 @@ static int iFileGetc (void)
 {
     int c;
 readnext:
-    c = getc (File.fp);
+    c = inputGetc ();
 
     /*  If previous character was a newline, then we're starting a line.
      */
@@ -347,8 +425,8 @@ readnext:
                 goto readnext;
             else
             {
-                fsetpos (File.fp, &StartOfLine);
-                c = getc (File.fp);
+                inputRewindToStartOfLine ();
+                c = inputGetc ();
             }
         }
     }
@@ -358,7 +436,7 @@ readnext:
     else if (c == NEWLINE)
     {
         File.newLine = TRUE;
-        fgetpos (File.fp, &StartOfLine);
+        inputMarkStartOfLine ();
     }
     else if (c == CRETURN)
     {
@@ -367,15 +445,15 @@ readnext:
          * and CR-LF (MS-DOS) are converted into a generic newline.
          */
 #ifndef macintosh
-        const int next = getc (File.fp);  /* is CR followed by LF? */
+        const int next = inputGetc ();  /* is CR followed by LF? */
         if (next != NEWLINE)
-            ungetc (next, File.fp);
+            inputUngetc (next);
         else
 #endif
         {
             c = NEWLINE;  /* convert CR into newline */
             File.newLine = TRUE;
-            fgetpos (File.fp, &StartOfLine);
+            inputMarkStartOfLine ();
         }
     }
     DebugStatement ( debugPutc (DEBUG_RAW, c); )
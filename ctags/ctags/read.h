@@ -72,6 +72,9 @@ typedef struct sInputFile {
     vString    *line;          /* last line read from file */
     const unsigned char* currentLine;  /* current line being worked on */
     FILE       *fp;            /* stream used for reading the file */
+    const unsigned char *buffer; /* memory buffer read instead of fp (if any) */
+    size_t      bufferSize;     /* size of the memory buffer */
+    size_t      bufferPosition; /* read position in the memory buffer */
     unsigned long lineNumber;  /* line number in the input file */
     fpos_t      filePosition;  /* file position of current line */
     int         ungetch;       /* a single character that was ungotten */
@@ -95,13 +98,14 @@ typedef struct sInputFile {
 /*
 *   GLOBAL VARIABLES
 */
-extern CONST_FILE inputFile File;
+extern CTAGS_THREAD_LOCAL CONST_FILE inputFile File;
 
 /*
 *   FUNCTION PROTOTYPES
 */
 extern void freeSourceFileResources (void);
 extern boolean fileOpen (const char *const fileName, const langType language);
+extern boolean bufferOpen (const char *const fileName, const unsigned char *const buffer, const size_t size, const langType language);
 extern boolean fileEOF (void);
 extern void fileClose (void);
 extern int fileGetc (void);
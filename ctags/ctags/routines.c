@@ -414,39 +414,41 @@ static boolean isAmigaDirectory (const char *const name)
 }
 #endif
 
-/* For caching of stat() calls */
+/* For caching of stat() calls, one cache per parsing thread */
+static CTAGS_THREAD_LOCAL fileStatus StatCache;
+
 extern fileStatus *eStat (const char *const fileName)
 {
     struct stat status;
-    static fileStatus file;
-    if (file.name == NULL  ||  strcmp (fileName, file.name) != 0)
+    fileStatus *const file = &StatCache;
+    if (file->name == NULL  ||  strcmp (fileName, file->name) != 0)
     {
-        eStatFree (&file);
-        file.name = eStrdup (fileName);
-        if (lstat (file.name, &status) != 0)
-            file.exists = FALSE;
+        eStatFree (file);
+        file->name = eStrdup (fileName);
+        if (lstat (file->name, &status) != 0)
+            file->exists = FALSE;
         else
         {
-            file.isSymbolicLink = (boolean) S_ISLNK (status.st_mode);
-            if (file.isSymbolicLink  &&  stat (file.name, &status) != 0)
-                file.exists = FALSE;
+            file->isSymbolicLink = (boolean) S_ISLNK (status.st_mode);
+            if (file->isSymbolicLink  &&  stat (file->name, &status) != 0)
+                file->exists = FALSE;
             else
             {
-                file.exists = TRUE;
+                file->exists = TRUE;
 #ifdef AMIGA
-                file.isDirectory = isAmigaDirectory (file.name);
+                file->isDirectory = isAmigaDirectory (file->name);
 #else
-                file.isDirectory = (boolean) S_ISDIR (status.st_mode);
+                file->isDirectory = (boolean) S_ISDIR (status.st_mode);
 #endif
-                file.isNormalFile = (boolean) (S_ISREG (status.st_mode));
-                file.isExecutable = (boolean) ((status.st_mode &
+                file->isNormalFile = (boolean) (S_ISREG (status.st_mode));
+                file->isExecutable = (boolean) ((status.st_mode &
                     (S_IXUSR | S_IXGRP | S_IXOTH)) != 0);
-                file.isSetuid = (boolean) ((status.st_mode & S_ISUID) != 0);
-                file.size = status.st_size;
+                file->isSetuid = (boolean) ((status.st_mode & S_ISUID) != 0);
+                file->size = status.st_size;
             }
         }
     }
-    return &file;
+    return file;
 }
 
 extern void eStatFree (fileStatus *status)
@@ -458,6 +460,11 @@ extern void eStatFree (fileStatus *status)
     }
 }
 
+extern void freeStatCache (void)
+{
+    eStatFree (&StatCache);
+}
+
 extern boolean doesFileExist (const char *const fileName)
 {
     fileStatus *status = eStat (fileName);
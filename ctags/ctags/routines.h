@@ -113,6 +113,7 @@ extern char* newUpperString (const char* str);
 extern void setCurrentDirectory (void);
 extern fileStatus *eStat (const char *const fileName);
 extern void eStatFree (fileStatus *status);
+extern void freeStatCache (void);
 extern boolean doesFileExist (const char *const fileName);
 extern boolean isRecursiveLink (const char* const dirName);
 extern boolean isSameFile (const char *const name1, const char *const name2);
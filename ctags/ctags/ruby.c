@@ -41,7 +41,7 @@ static kindOption RubyKinds [] = {
     { TRUE, 'F', "singleton method", "singleton methods" }
 };
 
-static stringList* nesting = 0;
+static CTAGS_THREAD_LOCAL stringList* nesting = 0;
 
 /*
 *   FUNCTION DEFINITIONS
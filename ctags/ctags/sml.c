@@ -65,7 +65,7 @@ static struct {
     { "val",       K_VAL       }
 };
 
-static unsigned int CommentLevel = 0;
+static CTAGS_THREAD_LOCAL unsigned int CommentLevel = 0;
 
 /*
  * FUNCTION DEFINITIONS
@@ -173,7 +173,7 @@ typedef struct sTokenInfoSQL {
 
 static langType Lang_sql;
 
-static jmp_buf Exception;
+static CTAGS_THREAD_LOCAL jmp_buf Exception;
 
 typedef enum {
     SQLTAG_CURSOR,
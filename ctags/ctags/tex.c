@@ -108,7 +108,7 @@ typedef struct sTokenInfo {
 
 static langType Lang_js;
 
-static jmp_buf Exception;
+static CTAGS_THREAD_LOCAL jmp_buf Exception;
 
 typedef enum {
     TEXTAG_CHAPTER,
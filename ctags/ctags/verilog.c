@@ -56,9 +56,9 @@ typedef struct {
 /*
  *   DATA DEFINITIONS
  */
-static int Ungetc;
+static CTAGS_THREAD_LOCAL int Ungetc;
 static int Lang_verilog;
-static jmp_buf Exception;
+static CTAGS_THREAD_LOCAL jmp_buf Exception;
 
 static kindOption VerilogKinds [] = {
  { TRUE, 'c', "constant",  "constants (define, parameter, specparam)" },
@@ -73,7 +73,7 @@ typedef enum eException {
  */
 
 #if 0
-static jmp_buf Exception;
+static CTAGS_THREAD_LOCAL jmp_buf Exception;
 #endif
 
 /*
@@ -100,6 +100,7 @@ HEADERS *= src/maininterface/ui/UIAbout.h \
     src/workspace/pAbstractChild.h \
     src/qscintillamanager/pEditor.h \
     src/qscintillamanager/qSciShortcutsManager.h \
+    src/qscintillamanager/pAPIs.h \
     src/workspace/pChild.h \
     src/workspace/UISaveFiles.h \
     src/workspace/pFileManager.h \
@@ -122,6 +123,7 @@ HEADERS *= src/maininterface/ui/UIAbout.h \
     src/pluginsmanager/ui/UIPluginsSettings.h \
     src/settingsmanager/Settings.h \
     src/coremanager/MonkeyCore.h \
+    src/coremanager/StartupProfiler.h \
     src/statusbar/StatusBar.h \
     src/pluginsmanager/ui/UIPluginsSettingsElement.h \
     src/pluginsmanager/ui/UIPluginsSettingsAbout.h \
@@ -143,6 +145,8 @@ HEADERS *= src/maininterface/ui/UIAbout.h \
     src/workspace/pOpenedFileModel.h \
     src/consolemanager/EnvironmentVariablesManager.h \
     src/consolemanager/pConsoleManagerStep.h \
+    src/consolemanager/pConsoleManagerParser.h \
+    src/consolemanager/pConsoleManagerBenchmark.h \
     src/xupmanager/core/XUPDynamicFolderItem.h \
     src/xupmanager/gui/XUPOpenedProjectsModel.h \
     src/xupmanager/gui/CommandsEditor.h \
@@ -164,6 +168,7 @@ SOURCES *= src/maininterface/ui/UIAbout.cpp \
     src/recentsmanager/pRecentsManager.cpp \
     src/qscintillamanager/pEditor.cpp \
     src/qscintillamanager/qSciShortcutsManager.cpp \
+    src/qscintillamanager/pAPIs.cpp \
     src/workspace/pChild.cpp \
     src/workspace/UISaveFiles.cpp \
     src/workspace/pFileManager.cpp \
@@ -183,6 +188,7 @@ SOURCES *= src/maininterface/ui/UIAbout.cpp \
     src/main.cpp \
     src/settingsmanager/Settings.cpp \
     src/coremanager/MonkeyCore.cpp \
+    src/coremanager/StartupProfiler.cpp \
     src/statusbar/StatusBar.cpp \
     src/pluginsmanager/ui/UIPluginsSettingsElement.cpp \
     src/pluginsmanager/ui/UIPluginsSettingsAbout.cpp \
@@ -205,6 +211,8 @@ SOURCES *= src/maininterface/ui/UIAbout.cpp \
     src/pluginsmanager/CLIToolPlugin.cpp \
     src/consolemanager/EnvironmentVariablesManager.cpp \
     src/consolemanager/pConsoleManagerStep.cpp \
+    src/consolemanager/pConsoleManagerParser.cpp \
+    src/consolemanager/pConsoleManagerBenchmark.cpp \
     src/xupmanager/core/XUPDynamicFolderItem.cpp \
     src/xupmanager/gui/XUPOpenedProjectsModel.cpp \
     src/xupmanager/gui/CommandsEditor.cpp \
@@ -21,8 +21,12 @@
 #include "main.h"
 #include "coremanager/MonkeyCore.h"
 #include "workspace/pFileManager.h"
+#include "consolemanager/pConsoleManagerBenchmark.h"
+#include "qCtagsSenseBenchmark.h"
 #include "pMonkeyStudio.h"
 
+#include <GetOpt.h>
+
 #include <QStringList>
 #include <QCoreApplication>
 #include <QDebug>
@@ -41,15 +45,45 @@ void CommandLineManager::parse()
     QStringList args = QCoreApplication::arguments();
     args.removeFirst();
     
+    // the long options are handled by GetOpt, with their value given after '=' or as the next argument
+    QStringList options;
+    
+    for ( int i = 0; i < args.count(); ) {
+        if ( !args.at( i ).startsWith( "--profile-startup" ) ) {
+            i++;
+            continue;
+        }
+        
+        const QString option = args.takeAt( i );
+        options << option;
+        
+        if ( option == "--profile-startup" && i < args.count() && !args.at( i ).startsWith( "-" ) ) {
+            options << args.takeAt( i );
+        }
+    }
+    
+    if ( !options.isEmpty() ) {
+        GetOpt opt( options );
+        QString traceFileName;
+        
+        opt.addOptionalOption( "profile-startup", &traceFileName, "monkeystudio-startup.json" );
+        
+        if ( opt.parse() && opt.isSet( "profile-startup" ) ) {
+            mArguments[ "--profile-startup" ] = QStringList( traceFileName );
+        }
+    }
+    
     for ( int i = 0; i < args.count(); i++ ) {
         const QString arg = args.at( i ).toLower();
         bool needNextArgument = false;
         
-        if ( arg == "-projects" || arg == "-files" ) {
-            needNextArgument = true;
+        // the argument is known even without parameters, repeating it adds to its parameters
+        if ( !mArguments.contains( arg ) ) {
+            mArguments[ arg ] = QStringList();
         }
-        else {
-            mArguments[ arg ].clear();
+        
+        if ( arg == "-projects" || arg == "-files" || arg == "-benchmark-parsers" || arg == "-benchmark-indexer" ) {
+            needNextArgument = true;
         }
         
         if ( needNextArgument ) {
@@ -59,7 +93,7 @@ void CommandLineManager::parse()
             
             QString param;
             
-            while ( !( param = args.at( i +1 ).toLower() ).startsWith( "-" ) ) {
+            while ( !( param = args.at( i +1 ) ).startsWith( "-" ) ) {
                 mArguments[ arg ] << param;
                 i++;
                 
@@ -86,6 +120,9 @@ void CommandLineManager::process()
         else if ( arg == "-files" ) {
             openFiles( mArguments[ arg ] );
         }
+        else if ( arg == "--profile-startup" ) {
+            // handled before the core initialization
+        }
         else {
             qWarning( "Unknow argument: %s (%s)", arg.toLocal8Bit().constData(), mArguments[ arg ].join( " " ).toLocal8Bit().constData() );
         }
@@ -116,6 +153,9 @@ void CommandLineManager::showHelp()
     qWarning( "\t-v, --version   Show program version" );
     qWarning( "\t-projects      Open the projects given as parameters (-projects project1 ...)" );
     qWarning( "\t-files         Open the files given as parameters (-files file1 ...)" );
+    qWarning( "\t--profile-startup [trace.json] Time the startup phases, write a Chrome trace and print a summary at exit" );
+    qWarning( "\t-benchmark-parsers Replay build logs through the output parsers without GUI and exit (-benchmark-parsers [script.mks ...] log1 ...)" );
+    qWarning( "\t-benchmark-indexer Time the symbols indexer tagging and writing on source trees without GUI and exit (-benchmark-indexer path1 ...)" );
 }
 
 void CommandLineManager::openProjects( const QStringList& fileNames )
@@ -131,6 +171,28 @@ void CommandLineManager::openProjects( const QStringList& fileNames )
     }
 }
 
+int CommandLineManager::benchmarkParsers( const QStringList& fileNames )
+{
+    if ( fileNames.isEmpty() ) {
+        qWarning( "Usage: -benchmark-parsers [script.mks ...] log1 ..." );
+        return 1;
+    }
+    
+    pConsoleManagerBenchmark benchmark( MonkeyCore::consoleManager() );
+    return benchmark.exec( fileNames );
+}
+
+int CommandLineManager::benchmarkIndexer( const QStringList& paths )
+{
+    if ( paths.isEmpty() ) {
+        qWarning( "Usage: -benchmark-indexer path1 ..." );
+        return 1;
+    }
+    
+    qCtagsSenseBenchmark benchmark;
+    return benchmark.exec( paths );
+}
+
 void CommandLineManager::openFiles( const QStringList& fileNames )
 {
     QDir dir( QCoreApplication::applicationDirPath() );
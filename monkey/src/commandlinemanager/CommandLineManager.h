@@ -38,6 +38,8 @@ public:
     void showHelp();
     void openProjects( const QStringList& fileNames );
     void openFiles( const QStringList& fileNames );
+    int benchmarkParsers( const QStringList& fileNames );
+    int benchmarkIndexer( const QStringList& paths );
 
 protected:
     QMap<QString, QStringList> mArguments;
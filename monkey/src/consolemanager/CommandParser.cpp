@@ -33,6 +33,196 @@
     #include <QTime>
 #endif
 
+static QStringList requiredAlternation( const QString& rx, int& i );
+
+static int shortestLength( const QStringList& literals )
+{
+    int length = -1;
+    
+    foreach ( const QString& literal, literals ) {
+        if ( length == -1 || literal.length() < length ) {
+            length = literal.length();
+        }
+    }
+    
+    return length;
+}
+
+/*!
+    Returns the literals of which one at least is part of any match of the regular expression
+    sequence starting at \a i, the sequence ending at the next '|' or ')'.
+    An empty list is returned when no such literal is found.
+*/
+static QStringList requiredSequence( const QString& rx, int& i )
+{
+    QList<QStringList> candidates;
+    QString run;
+    
+    while ( i < rx.length() && rx[ i ] != '|' && rx[ i ] != ')' ) {
+        const QChar c = rx[ i ];
+        bool isLiteral = false;
+        bool isGroup = false;
+        QChar literal;
+        QStringList group;
+        
+        if ( c == '\\' ) {
+            const QChar e = i +1 < rx.length() ? rx[ i +1 ] : QChar();
+            i += 2;
+            
+            if ( e == 'n' || e == 't' || e == 'r' ) {
+                isLiteral = true;
+                literal = e == 'n' ? '\n' : ( e == 't' ? '\t' : '\r' );
+            }
+            else if ( e == 'x' || e == '0' ) {
+                // character codes are not used as literals, skip their digits
+                const QString digits = e == 'x' ? "0123456789abcdefABCDEF" : "01234567";
+                const int maximum = e == 'x' ? 4 : 3;
+                
+                for ( int count = 0; i < rx.length() && count < maximum && digits.contains( rx[ i ] ); count++ ) {
+                    i++;
+                }
+            }
+            else if ( !e.isNull() && !e.isLetterOrNumber() ) {
+                isLiteral = true;
+                literal = e;
+            }
+        }
+        else if ( c == '[' ) {
+            i++;
+            
+            if ( i < rx.length() && rx[ i ] == '^' ) {
+                i++;
+            }
+            
+            if ( i < rx.length() && rx[ i ] == ']' ) {
+                i++;
+            }
+            
+            while ( i < rx.length() && rx[ i ] != ']' ) {
+                i += rx[ i ] == '\\' ? 2 : 1;
+            }
+            
+            i++;
+        }
+        else if ( c == '(' ) {
+            if ( rx.mid( i, 3 ) == "(?=" || rx.mid( i, 3 ) == "(?!" ) {
+                // lookaheads don't consume anything
+                i += 3;
+                requiredAlternation( rx, i );
+            }
+            else {
+                i += rx.mid( i, 3 ) == "(?:" ? 3 : 1;
+                group = requiredAlternation( rx, i );
+                isGroup = true;
+            }
+            
+            i++;
+        }
+        else if ( c == '.' || c == '^' || c == '$' ) {
+            i++;
+        }
+        else {
+            isLiteral = true;
+            literal = c;
+            i++;
+        }
+        
+        // quantifier
+        bool optional = false;
+        bool repeated = false;
+        
+        if ( i < rx.length() && ( rx[ i ] == '*' || rx[ i ] == '+' || rx[ i ] == '?' ) ) {
+            optional = rx[ i ] != '+';
+            repeated = true;
+            i++;
+        }
+        else if ( i < rx.length() && rx[ i ] == '{' ) {
+            const int end = rx.indexOf( '}', i );
+            const QString minimum = rx.mid( i +1, end -i -1 ).section( ',', 0, 0 ).trimmed();
+            optional = minimum.isEmpty() || minimum.toInt() == 0;
+            repeated = true;
+            i = end == -1 ? rx.length() : end +1;
+        }
+        
+        if ( isLiteral && !optional ) {
+            run.append( literal );
+        }
+        
+        if ( !isLiteral || optional || repeated ) {
+            if ( !run.isEmpty() ) {
+                candidates << ( QStringList() << run );
+                run.clear();
+            }
+        }
+        
+        if ( isGroup && !optional && !group.isEmpty() ) {
+            candidates << group;
+        }
+    }
+    
+    if ( !run.isEmpty() ) {
+        candidates << ( QStringList() << run );
+    }
+    
+    // the most selective candidate: longest shortest literal, then fewest alternatives
+    QStringList best;
+    
+    foreach ( const QStringList& candidate, candidates ) {
+        const int length = shortestLength( candidate );
+        const int bestLength = shortestLength( best );
+        
+        if ( best.isEmpty() || length > bestLength || ( length == bestLength && candidate.count() < best.count() ) ) {
+            best = candidate;
+        }
+    }
+    
+    return best;
+}
+
+static QStringList requiredAlternation( const QString& rx, int& i )
+{
+    QStringList literals = requiredSequence( rx, i );
+    bool constrained = !literals.isEmpty();
+    
+    while ( i < rx.length() && rx[ i ] == '|' ) {
+        i++;
+        const QStringList alternative = requiredSequence( rx, i );
+        constrained = constrained && !alternative.isEmpty();
+        
+        foreach ( const QString& literal, alternative ) {
+            if ( !literals.contains( literal ) ) {
+                literals << literal;
+            }
+        }
+    }
+    
+    return constrained ? literals : QStringList();
+}
+
+/*!
+    Returns literals of which one at least is contained in any string matched by \a regExp,
+    they are used to skip lines without running the regular expression.
+    An empty list is returned when the expression can't be analyzed.
+*/
+static QStringList requiredLiterals( const QRegExp& regExp )
+{
+    if ( regExp.caseSensitivity() != Qt::CaseSensitive
+        || ( regExp.patternSyntax() != QRegExp::RegExp && regExp.patternSyntax() != QRegExp::RegExp2 ) ) {
+        return QStringList();
+    }
+    
+    const QString pattern = regExp.pattern();
+    int i = 0;
+    const QStringList literals = requiredAlternation( pattern, i );
+    
+    // unbalanced expression
+    if ( i < pattern.length() ) {
+        return QStringList();
+    }
+    
+    return literals;
+}
+
 //! Implementation for 'parser' MkS scripting interface command
 QString CommandParser::parserCommandImplementation( const QString& command, const QStringList& arguments, int* status, class MkSShellInterpreter* interpreter, void* data )
 {
@@ -137,6 +327,26 @@ QString CommandParser::parserCommandImplementation( const QString& command, cons
     return QString::null;
 }
 
+//! Validates 'parser' commands when a MkS script is compiled, so invalid patterns never reach the parsers
+QString CommandParser::parserCommandValidator( const QString& command, const QStringList& arguments )
+{
+    if ( arguments.value( 0 ) != "add" ) {
+        return QString::null;
+    }
+    
+    if ( arguments.size() != 9 ) {
+        return QString( "Command '%1' has 9 arguments" ).arg( command );
+    }
+    
+    const QRegExp regExp( arguments[ 2 ], Qt::CaseSensitive, QRegExp::RegExp2 );
+    
+    if ( !regExp.isValid() ) {
+        return QString( "Invalid regular expression '%1': %2" ).arg( arguments[ 2 ] ).arg( regExp.errorString() );
+    }
+    
+    return QString::null;
+}
+
 void CommandParser::installParserCommand()
 {
     QString help = tr( "This command allows one to add and remove console output parsing patterns. Usage:\n"
@@ -144,6 +354,9 @@ void CommandParser::installParserCommand()
                         "\tparser list\n" );
     
     MkSShellInterpreter::instance()->addCommandImplementation( "parser", parserCommandImplementation, help, 0 );
+    MkSShellInterpreter::instance()->setCommandValidator( "parser", parserCommandValidator );
+    // parsers scripts are executed the first time a parser is requested
+    MkSShellInterpreter::instance()->setCommandDeferrable( "parser", true );
 }
 
 CommandParser::CommandParser(QObject* parent, const QString& name):
@@ -162,6 +375,21 @@ void CommandParser::addPattern(const Pattern& pattern)
     
     mPatterns.append(pattern);
     
+    QList<int> literals;
+    
+    foreach(const QString& literal, requiredLiterals(pattern.regExp)) {
+        int index = mLiterals.indexOf(literal);
+        
+        if (index == -1) {
+            index = mLiterals.count();
+            mLiterals << literal;
+        }
+        
+        literals << index;
+    }
+    
+    mPatternsLiterals.append(literals);
+    
 #if 0
     qDebug() << "Added pattern " << pattern.regExp.pattern() << 
                                     pattern.FileName << 
@@ -180,8 +408,36 @@ void CommandParser::removePattern(const QString& regExp)
         if (mPatterns[i].regExp.pattern() == regExp)
         {
             mPatterns.removeAt(i);
+            mPatternsLiterals.removeAt(i);
+        }
+    }
+}
+
+/*!
+    Returns false if \a line can't match the pattern at index \a pattern, as it contains none of its required literals.
+    \a literalsFound caches the literals looked for in the line: -1 not looked for yet, 0 not found, 1 found.
+*/
+bool CommandParser::mayMatch(int pattern, const QString& line, QVector<int>& literalsFound) const
+{
+    const QList<int>& literals = mPatternsLiterals[ pattern ];
+    
+    if ( literals.isEmpty() ) {
+        return true;
+    }
+    
+    foreach ( const int index, literals ) {
+        int& found = literalsFound[ index ];
+        
+        if ( found == -1 ) {
+            found = line.contains( mLiterals[ index ] ) ? 1 : 0;
+        }
+        
+        if ( found == 1 ) {
+            return true;
         }
     }
+    
+    return false;
 }
 
 /*!
@@ -199,10 +455,20 @@ void CommandParser::processParsing(QStringList& strings)
     const QStringList lines = strings;
     int removed = 0;
     
+    QVector<int> literalsFound;
+    
     for ( int i = 0; i < lines.count(); i++ ) {
         const QString& line = lines[ i ];
         
-        foreach ( const Pattern& p, mPatterns ) {
+        literalsFound.fill( -1, mLiterals.count() );
+        
+        for ( int j = 0; j < mPatterns.count(); j++ ) {
+            // cheap literals test before running the regular expression
+            if ( !mayMatch( j, line, literalsFound ) ) {
+                continue;
+            }
+            
+            const Pattern& p = mPatterns[ j ];
             const int pos = p.regExp.indexIn( line );
         
 #if PARSERS_DEBUG
@@ -228,7 +494,7 @@ void CommandParser::processParsing(QStringList& strings)
                 qDebug () << "Capture :" << p.regExp.cap();
                 qDebug () << "CaptureS :" << p.regExp.capturedTexts ();
 #endif
-                break; // foreach
+                break; // for
             }
             else {
 #if PARSERS_DEBUG
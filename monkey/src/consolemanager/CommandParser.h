@@ -28,6 +28,8 @@
 
 #include "AbstractCommandParser.h"
 
+#include <QVector>
+
 /*!
     Class implements parsing based on patterns.
     It is used by the majority of parsers used in MkS (all parsers on 28-10-2009)
@@ -66,9 +68,13 @@ protected:
     
     QString mName;
     QList <Pattern> mPatterns;
+    QStringList mLiterals; // literals required by the patterns, tested once per line
+    QList<QList<int> > mPatternsLiterals; // for each pattern, indexes in mLiterals of which one must be in a matching line
     
+    bool mayMatch(int pattern, const QString& line, QVector<int>& literalsFound) const;
     QString replaceWithMatch(const QRegExp&, const QString&) const;
     static QString parserCommandImplementation( const QString& command, const QStringList& arguments, int* status, class MkSShellInterpreter* interpreter, void* data );
+    static QString parserCommandValidator( const QString& command, const QStringList& arguments );
     
 public:
     CommandParser(QObject* parent, const QString& name);
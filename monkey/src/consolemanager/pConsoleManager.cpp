@@ -32,17 +32,15 @@
 #include <QDebug>
 
 #include "pConsoleManager.h"
+#include "pConsoleManagerParser.h"
 #include "CommandParser.h"
 #include "AbstractCommandParser.h"
 
 #include "coremanager/MonkeyCore.h"
 #include <pActionsManager.h>
 #include "variablesmanager/VariablesManager.h"
+#include "shellmanager/MkSShellInterpreter.h"
 
-/*!
-    Defines maximum count of lines, which are storing in the buffer for parsing
-*/
-static const int MAX_LINES = 4; //Maximum lines count, that can be parsed by Monkey. Than less - than better perfomance
 #define QUOTE_STRING "\""
 
 /*!
@@ -82,6 +80,10 @@ pConsoleManager::pConsoleManager( QObject* o )
     mTimer->setSingleShot( true );
     connect( mTimer, SIGNAL( timeout() ), this, SLOT( timeout() ) );
     mStopAttempt = 0;
+    // output parsing thread
+    mParser = new pConsoleManagerParser( this );
+    connect( mParser, SIGNAL( stepsAvailable() ), this, SLOT( parser_stepsAvailable() ) );
+    mParser->start();
     
     CommandParser::installParserCommand();
 }
@@ -111,8 +113,9 @@ void pConsoleManager::addParser( AbstractCommandParser* p )
     }
     
     mParsers[p->name()] = p;
-    connect( p, SIGNAL( newStepAvailable( const pConsoleManagerStep& ) ), this, SIGNAL( newStepAvailable( const pConsoleManagerStep& ) ) );
-    connect( p, SIGNAL( newStepsAvailable( const pConsoleManagerStepList& ) ), this, SIGNAL( newStepsAvailable( const pConsoleManagerStepList& ) ) );
+    // parsers run in the parsing thread, their steps are collected there and emitted by batches
+    connect( p, SIGNAL( newStepAvailable( const pConsoleManagerStep& ) ), mParser, SLOT( collectStep( const pConsoleManagerStep& ) ), Qt::DirectConnection );
+    connect( p, SIGNAL( newStepsAvailable( const pConsoleManagerStepList& ) ), mParser, SLOT( collectSteps( const pConsoleManagerStepList& ) ), Qt::DirectConnection );
 }
 
 /*!
@@ -123,8 +126,8 @@ void pConsoleManager::removeParser( AbstractCommandParser* p )
 {
     if ( p && mParsers.contains( p->name() ) )
     {
-        disconnect( p, SIGNAL( newStepAvailable( const pConsoleManagerStep& ) ), this, SIGNAL( newStepAvailable( const pConsoleManagerStep& ) ) );
-        disconnect( p, SIGNAL( newStepsAvailable( const pConsoleManagerStepList& ) ), this, SIGNAL( newStepsAvailable( const pConsoleManagerStepList& ) ) );
+        disconnect( p, SIGNAL( newStepAvailable( const pConsoleManagerStep& ) ), mParser, SLOT( collectStep( const pConsoleManagerStep& ) ) );
+        disconnect( p, SIGNAL( newStepsAvailable( const pConsoleManagerStepList& ) ), mParser, SLOT( collectSteps( const pConsoleManagerStepList& ) ) );
         mParsers.remove( p->name() );
     }
 }
@@ -141,9 +144,19 @@ void pConsoleManager::removeParser( const QString& s )
  */
 AbstractCommandParser* pConsoleManager::getParser(const QString& name) const
 {
+    MkSShellInterpreter::instance()->executeDeferredScripts( "parser" );
     return mParsers.value(name);
 }
 
+/*!
+    Returns the names of the available parsers, executing the deferred parsers scripts if needed
+ */
+QStringList pConsoleManager::parsersName() const
+{
+    MkSShellInterpreter::instance()->executeDeferredScripts( "parser" );
+    return mParsers.keys();
+}
+
 /*!
     Replace internal varibles in the string with it's values
 
@@ -309,9 +322,7 @@ void pConsoleManager::started()
 */
 void pConsoleManager::readyRead()
 {
-    // append data to buffer to parse
     const QByteArray data = readAll();
-    mBuffer.buffer().append( data );
     
     // get current command
     const pCommand command = currentCommand();
@@ -320,12 +331,8 @@ void pConsoleManager::readyRead()
     if ( !command.isValid() )
         return;
     
-    /*Alrorithm is not ideal, need fix, if will be problems with it
-        Some text, that next parser possible to parse, can be removed
-        And, possible, it's not idealy quick.   hlamer
-        */
-
-    parseOutput( false );
+    // parsing is done in the parser thread
+    mParser->appendData( data );
 
     // emit signal
     emit commandReadyRead( command, data );
@@ -340,16 +347,15 @@ void pConsoleManager::readyRead()
 void pConsoleManager::finished( int i, QProcess::ExitStatus e )
 {
     const pCommand command = currentCommand();
-    // parse output
-    parseOutput( true );
+    // parse the remaining output, its steps come before the finish
+    mParser->finish();
+    parser_stepsAvailable();
     // emit signal finished
     emit commandFinished( command, i, e );
     // remove command from list
     removeCommand( command );
     // disable stop action
     mStopAction->setEnabled( false );
-    // clear buffer
-    mBuffer.buffer().clear();
 }
 
 /*!
@@ -576,79 +582,31 @@ void pConsoleManager::executeProcess()
     variables.prepend( QString( "PWD=%1" ).arg( workingDirectory().isEmpty() ? QDir::homePath() : workingDirectory() ) );
     
     mCommands.first() = c;
-    mBuffer.open( QBuffer::ReadOnly );
+    
+    QList<AbstractCommandParser*> parsers;
+    
+    foreach ( const QString& parserName, mCurrentParsers ) {
+        AbstractCommandParser* parser = getParser( parserName );
+        
+        if ( parser ) {
+            parsers << parser;
+        }
+    }
+    
+    mParser->begin( parsers );
     
     setEnvironment( variables );
     start( c.command().trimmed() );
 }
 
 /*!
-    Parse output of command, which are storing in the buffer, using parsers.
-
-    \param commandFinished If command already are finished, make processing while
-    buffer will not be empty. If not finished - wait for further output.
+    Emits the steps found by the parser thread
 */
-void pConsoleManager::parseOutput( bool commandFinished )
+void pConsoleManager::parser_stepsAvailable()
 {
-    static QStringList strings;
+    const pConsoleManagerStepList steps = mParser->takeSteps();
     
-    forever {
-        // fill parsing buffer
-        while ( mBuffer.canReadLine() && strings.count() < MAX_LINES ) {
-            strings << QString::fromLocal8Bit( mBuffer.readLine() );
-        }
-        
-#if PARSERS_DEBUG
-        qWarning() << "CommandFinished/Strings" << commandFinished << strings;
-#endif
-
-        // read last line not ending by a \n on command finished
-        if ( commandFinished && strings.count() < MAX_LINES ) {
-            const QString line = QString::fromLocal8Bit( mBuffer.readAll() );
-            
-            if ( !line.isEmpty() ) {
-                strings << line;
-                
-#if PARSERS_DEBUG
-                qWarning() << "Add finished command last line" << line;
-#endif
-            }
-        }
-        
-        if ( strings.isEmpty() ) {
-#if PARSERS_DEBUG
-            qWarning() << "Empty strings, exiting / CommandFinished" << commandFinished;
-#endif
-            return;
-        }
-        
-        // try current command parsers
-        foreach ( const QString& parserName, mCurrentParsers ) {
-            AbstractCommandParser* parser = mParsers.value( parserName );
-            
-            if ( !parser ) {
-#if PARSERS_DEBUG
-                qWarning() << "Invalid parser" << parserName;
-                qWarning() << mParsers;
-#endif
-                continue; // foreach
-            }
-            
-            // parse content
-#if PARSERS_DEBUG
-            qWarning() << "Parsing..." << strings;
-#endif
-            parser->processParsing( strings );
-#if PARSERS_DEBUG
-            qWarning() << "Parsed fails..." << strings;
-#endif
-            
-            if ( strings.isEmpty() ) {
-                break; // foreach
-            }
-        }
-        
-        // discarding unconsuming data
-        strings.clear();
+    if ( !steps.isEmpty() ) {
+        emit newStepsAvailable( steps );
     }
 }
@@ -38,6 +38,7 @@
 #include <QHash>
 
 class AbstractCommandParser;
+class pConsoleManagerParser;
 class QAction;
 class QTimer;
 
@@ -53,10 +54,10 @@ class Q_MONKEY_EXPORT pConsoleManager : public QProcess
 {
     Q_OBJECT
     friend class MonkeyCore;
+    friend class pConsoleManagerBenchmark;
     
 public:
     inline pCommand currentCommand() const { return mCommands.value( 0 ); }
-    inline QStringList parsersName() const { return mParsers.keys(); }
     inline QAction* stopAction() const { return mStopAction; }
     inline EnvironmentVariablesManager* environmentVariablesManager() const { return &mEnvironmentVariablesManager; }
     
@@ -64,6 +65,7 @@ public:
     void removeParser( AbstractCommandParser* parser );
     void removeParser( const QString& parser );
     AbstractCommandParser* getParser( const QString& name ) const;
+    QStringList parsersName() const;
     
     QString processInternalVariables( const QString& string, bool quoteValues ) const;
     pCommand processCommand( const pCommand& command ) const;
@@ -75,7 +77,7 @@ public:
 
 protected:
     QTimer* mTimer;
-    QBuffer mBuffer; //All output comming to this buffer
+    pConsoleManagerParser* mParser; // parse the output out of the GUI thread
     pCommand::List mCommands;
     QStringList mCurrentParsers;
     QHash<QString, AbstractCommandParser*> mParsers;
@@ -86,11 +88,6 @@ protected:
     pConsoleManager( QObject* = 0 );
     ~pConsoleManager();
 
-    /*
-    Parse output, that are in the mBuffer.   
-    */
-    void parseOutput( bool commandFinished );
-
 public slots:
     void sendRawCommand( const QString& );
     void sendRawData( const QByteArray& );
@@ -108,6 +105,7 @@ private slots:
     void readyRead();
     void started();
     void stateChanged( QProcess::ProcessState );
+    void parser_stepsAvailable();
 
 signals:
     void warning( const QString& message );
@@ -0,0 +1,212 @@
+/****************************************************************************
+    Copyright (C) 2005 - 2011  Filipe AZEVEDO & The Monkey Studio Team
+    http://monkeystudio.org licensing under the GNU GPL.
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+****************************************************************************/
+/*!
+    \file pConsoleManagerBenchmark.cpp
+    \brief Implementation of pConsoleManagerBenchmark class
+*/
+
+#include "pConsoleManagerBenchmark.h"
+#include "pConsoleManager.h"
+#include "pConsoleManagerParser.h"
+#include "AbstractCommandParser.h"
+
+#include "coremanager/MonkeyCore.h"
+#include "settingsmanager/Settings.h"
+#include "shellmanager/MkSShellInterpreter.h"
+
+#include <QFile>
+#include <QFileInfo>
+#include <QDir>
+#include <QSet>
+#include <QElapsedTimer>
+
+#if defined( Q_OS_LINUX )
+    #include <malloc.h>
+#endif
+
+/*!
+    Size of the chunks given to the parsing thread, close to what QProcess reads at once
+*/
+static const int CHUNK_SIZE = 4096;
+
+pConsoleManagerBenchmark::pConsoleManagerBenchmark( pConsoleManager* manager )
+{
+    Q_ASSERT( manager );
+    mManager = manager;
+    mChunkSize = CHUNK_SIZE;
+}
+
+/*!
+    Execute the parsers scripts
+    \param fileNames Scripts to execute, if empty the parser-*.mks scripts of the scripts storage paths are used
+    \return true if all scripts were executed, else false
+*/
+bool pConsoleManagerBenchmark::loadScripts( const QStringList& fileNames )
+{
+    QStringList scripts = fileNames;
+    
+    if ( scripts.isEmpty() ) {
+        QSet<QString> names;
+        
+        foreach ( const QString& path, MonkeyCore::settings()->storagePaths( Settings::SP_SCRIPTS ) ) {
+            foreach ( const QFileInfo& file, QDir( path ).entryInfoList( QStringList( "parser-*.mks" ) ) ) {
+                if ( !names.contains( file.fileName() ) ) {
+                    names << file.fileName();
+                    scripts << file.absoluteFilePath();
+                }
+            }
+        }
+    }
+    
+    bool ok = true;
+    
+    foreach ( const QString& fileName, scripts ) {
+        if ( MonkeyCore::interpreter()->loadScript( fileName ) ) {
+            qWarning( "Script loaded: %s", fileName.toLocal8Bit().constData() );
+        }
+        else {
+            qWarning( "Can't load script: %s", fileName.toLocal8Bit().constData() );
+            ok = false;
+        }
+    }
+    
+    return ok;
+}
+
+/*!
+    Replay a log through all the available parsers and report the figures
+    \param fileName Log to replay
+    \return true if the log was replayed, else false
+*/
+bool pConsoleManagerBenchmark::replay( const QString& fileName )
+{
+    QFile file( fileName );
+    
+    if ( !file.open( QIODevice::ReadOnly ) ) {
+        qWarning( "Can't open log: %s", fileName.toLocal8Bit().constData() );
+        return false;
+    }
+    
+    const QByteArray log = file.readAll();
+    file.close();
+    
+    QList<AbstractCommandParser*> parsers;
+    
+    foreach ( const QString& name, mManager->parsersName() ) {
+        parsers << mManager->getParser( name );
+    }
+    
+    const qint64 lines = log.count( '\n' ) +( log.isEmpty() || log.endsWith( '\n' ) ? 0 : 1 );
+    const qint64 heapStart = heapUsage();
+    qint64 heapPeak = heapStart;
+    qint64 steps = 0;
+    QElapsedTimer timer;
+    
+    timer.start();
+    mManager->mParser->begin( parsers );
+    
+    for ( int i = 0; i < log.size(); i += mChunkSize ) {
+        mManager->mParser->appendData( log.mid( i, mChunkSize ) );
+        steps += mManager->mParser->takeSteps().count();
+        heapPeak = qMax( heapPeak, heapUsage() );
+    }
+    
+    mManager->mParser->finish();
+    heapPeak = qMax( heapPeak, heapUsage() );
+    steps += mManager->mParser->takeSteps().count();
+    
+    const qint64 elapsed = timer.elapsed();
+    const qint64 heapEnd = heapUsage();
+    const double seconds = qMax( elapsed, qint64( 1 ) ) /1000.0;
+    
+    qWarning( "%s", fileName.toLocal8Bit().constData() );
+    qWarning( "\t%lld lines, %lld bytes, %lld steps in %lld ms", lines, qint64( log.size() ), steps, elapsed );
+    qWarning( "\t%.0f lines/s, %.0f steps/s, %.2f MiB/s", lines /seconds, steps /seconds, log.size() /seconds /( 1024 *1024 ) );
+    
+    if ( heapStart == -1 ) {
+        qWarning( "\theap usage not available on this platform" );
+    }
+    else {
+        qWarning( "\theap peak +%lld KiB, retained +%lld KiB", ( heapPeak -heapStart ) /1024, ( heapEnd -heapStart ) /1024 );
+    }
+    
+    return true;
+}
+
+/*!
+    Run the benchmark
+    \param fileNames The logs to replay, and the parsers scripts (*.mks) to use instead of the default ones
+    \return The process exit code
+*/
+int pConsoleManagerBenchmark::exec( const QStringList& fileNames )
+{
+    QStringList scripts;
+    QStringList logs;
+    
+    foreach ( const QString& fileName, fileNames ) {
+        const QString filePath = QFileInfo( fileName ).absoluteFilePath();
+        
+        if ( filePath.endsWith( ".mks", Qt::CaseInsensitive ) ) {
+            scripts << filePath;
+        }
+        else {
+            logs << filePath;
+        }
+    }
+    
+    if ( logs.isEmpty() ) {
+        qWarning( "No log to replay (-benchmark-parsers [script.mks ...] log1 ...)" );
+        return 1;
+    }
+    
+    if ( !loadScripts( scripts ) ) {
+        return 1;
+    }
+    
+    if ( mManager->parsersName().isEmpty() ) {
+        qWarning( "No parser available" );
+        return 1;
+    }
+    
+    qWarning( "Parsers: %s", mManager->parsersName().join( ", " ).toLocal8Bit().constData() );
+    
+    bool ok = true;
+    
+    foreach ( const QString& fileName, logs ) {
+        ok = replay( fileName ) && ok;
+    }
+    
+    return ok ? 0 : 1;
+}
+
+/*!
+    Returns the bytes allocated on the heap, or -1 if it can't be known
+*/
+qint64 pConsoleManagerBenchmark::heapUsage()
+{
+#if defined( __GLIBC__ ) && ( __GLIBC__ > 2 || ( __GLIBC__ == 2 && __GLIBC_MINOR__ >= 33 ) )
+    const struct mallinfo2 info = mallinfo2();
+    return info.uordblks +info.hblkhd;
+#elif defined( __GLIBC__ )
+    const struct mallinfo info = mallinfo();
+    return qint64( info.uordblks ) +info.hblkhd;
+#else
+    return -1;
+#endif
+}
@@ -0,0 +1,56 @@
+/****************************************************************************
+    Copyright (C) 2005 - 2011  Filipe AZEVEDO & The Monkey Studio Team
+    http://monkeystudio.org licensing under the GNU GPL.
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+****************************************************************************/
+/*!
+    \file pConsoleManagerBenchmark.h
+    \brief Header of pConsoleManagerBenchmark class
+*/
+
+#ifndef PCONSOLEMANAGERBENCHMARK_H
+#define PCONSOLEMANAGERBENCHMARK_H
+
+#include <MonkeyExport.h>
+
+#include <QStringList>
+
+class pConsoleManager;
+
+/*!
+    Replays recorded build logs through the console manager parsing path, without GUI.
+    
+    The parsers are loaded from the parser-*.mks scripts by the shell interpreter, the logs
+    are fed by chunks to the parsing thread like a running command output would be, and
+    the lines/s, steps/s and heap usage of each replay are reported on the console.
+*/
+class Q_MONKEY_EXPORT pConsoleManagerBenchmark
+{
+public:
+    pConsoleManagerBenchmark( pConsoleManager* manager );
+    
+    bool loadScripts( const QStringList& fileNames );
+    bool replay( const QString& fileName );
+    int exec( const QStringList& fileNames );
+
+protected:
+    pConsoleManager* mManager;
+    int mChunkSize;
+    
+    static qint64 heapUsage();
+};
+
+#endif // PCONSOLEMANAGERBENCHMARK_H
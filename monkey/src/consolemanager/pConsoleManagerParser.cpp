@@ -0,0 +1,225 @@
+/****************************************************************************
+    Copyright (C) 2005 - 2011  Filipe AZEVEDO & The Monkey Studio Team
+    http://monkeystudio.org licensing under the GNU GPL.
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+****************************************************************************/
+/*!
+    \file pConsoleManagerParser.cpp
+    \brief Implementation of pConsoleManagerParser class
+*/
+
+#include "pConsoleManagerParser.h"
+#include "AbstractCommandParser.h"
+
+#include <QMutexLocker>
+#include <QStringList>
+
+/*!
+    Defines maximum count of lines, which are given at once to the parsers
+*/
+static const int MAX_LINES = 4; //Maximum lines count, that can be parsed by Monkey. Than less - than better perfomance
+
+pConsoleManagerParser::pConsoleManagerParser( QObject* parent )
+    : QThread( parent )
+{
+    mBegin = false;
+    mFinish = false;
+    mParsing = false;
+    mExit = false;
+    mStepsNotified = false;
+}
+
+pConsoleManagerParser::~pConsoleManagerParser()
+{
+    stop();
+    wait();
+}
+
+/*!
+    Prepare the parsing of a new command output
+    \param parsers Parsers of the command
+*/
+void pConsoleManagerParser::begin( const QList<AbstractCommandParser*>& parsers )
+{
+    QMutexLocker locker( &mMutex );
+    mParsers = parsers;
+    mData.clear();
+    mBegin = true;
+    mFinish = false;
+    mDataAvailable.wakeAll();
+}
+
+/*!
+    Queue output of the current command for parsing
+    \param data Raw output
+*/
+void pConsoleManagerParser::appendData( const QByteArray& data )
+{
+    QMutexLocker locker( &mMutex );
+    mData.append( data );
+    mDataAvailable.wakeAll();
+}
+
+/*!
+    Parse the remaining output of the finished command, including its last line not ending by a \\n.
+    Returns once everything is parsed, the steps being available with takeSteps().
+*/
+void pConsoleManagerParser::finish()
+{
+    QMutexLocker locker( &mMutex );
+    mFinish = true;
+    mDataAvailable.wakeAll();
+    
+    while ( isRunning() && ( mBegin || mFinish || mParsing || !mData.isEmpty() ) ) {
+        mDataParsed.wait( &mMutex );
+    }
+}
+
+void pConsoleManagerParser::stop()
+{
+    QMutexLocker locker( &mMutex );
+    mExit = true;
+    mDataAvailable.wakeAll();
+}
+
+/*!
+    Returns the steps found since the last call
+*/
+pConsoleManagerStepList pConsoleManagerParser::takeSteps()
+{
+    QMutexLocker locker( &mStepsMutex );
+    const pConsoleManagerStepList steps = mSteps;
+    mSteps.clear();
+    mStepsNotified = false;
+    return steps;
+}
+
+/*!
+    Called by the parsers, from the thread
+*/
+void pConsoleManagerParser::collectStep( const pConsoleManagerStep& step )
+{
+    QMutexLocker locker( &mStepsMutex );
+    mSteps << step;
+}
+
+/*!
+    Called by the parsers, from the thread
+*/
+void pConsoleManagerParser::collectSteps( const pConsoleManagerStepList& steps )
+{
+    QMutexLocker locker( &mStepsMutex );
+    mSteps << steps;
+}
+
+void pConsoleManagerParser::parse( const QByteArray& data, bool finish, const QList<AbstractCommandParser*>& parsers )
+{
+    QStringList strings;
+    int start = 0;
+    int eol;
+    
+    mPending.append( data );
+    
+    while ( ( eol = mPending.indexOf( '\n', start ) ) != -1 ) {
+        strings << QString::fromLocal8Bit( mPending.constData() +start, eol +1 -start );
+        start = eol +1;
+        
+        if ( strings.count() == MAX_LINES ) {
+            parseLines( strings, parsers );
+        }
+    }
+    
+    mPending.remove( 0, start );
+    
+    // read last line not ending by a \n on command finished
+    if ( finish && !mPending.isEmpty() ) {
+        strings << QString::fromLocal8Bit( mPending );
+        mPending.clear();
+    }
+    
+    parseLines( strings, parsers );
+    
+    // one notification for all the steps found until the GUI takes them
+    bool notify = false;
+    
+    {
+        QMutexLocker locker( &mStepsMutex );
+        notify = !mSteps.isEmpty() && !mStepsNotified;
+        mStepsNotified = mStepsNotified || notify;
+    }
+    
+    if ( notify ) {
+        emit stepsAvailable();
+    }
+}
+
+void pConsoleManagerParser::parseLines( QStringList& strings, const QList<AbstractCommandParser*>& parsers )
+{
+    // try current command parsers
+    foreach ( AbstractCommandParser* parser, parsers ) {
+        if ( strings.isEmpty() ) {
+            break; // foreach
+        }
+        
+        parser->processParsing( strings );
+    }
+    
+    // discarding unconsuming data
+    strings.clear();
+}
+
+void pConsoleManagerParser::run()
+{
+    forever {
+        QList<AbstractCommandParser*> parsers;
+        QByteArray data;
+        bool finish = false;
+        
+        {
+            QMutexLocker locker( &mMutex );
+            
+            while ( !mExit && !mBegin && !mFinish && mData.isEmpty() ) {
+                mParsing = false;
+                mDataParsed.wakeAll();
+                mDataAvailable.wait( &mMutex );
+            }
+            
+            if ( mExit ) {
+                mParsing = false;
+                mDataParsed.wakeAll();
+                return;
+            }
+            
+            if ( mBegin ) {
+                mPending.clear();
+                mBegin = false;
+            }
+            
+            parsers = mParsers;
+            data = mData;
+            finish = mFinish;
+            mData.clear();
+            mFinish = false;
+            mParsing = true;
+        }
+        
+        parse( data, finish, parsers );
+        
+        if ( finish ) {
+            mPending.clear();
+        }
+    }
+}
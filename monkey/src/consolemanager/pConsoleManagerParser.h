@@ -0,0 +1,87 @@
+/****************************************************************************
+    Copyright (C) 2005 - 2011  Filipe AZEVEDO & The Monkey Studio Team
+    http://monkeystudio.org licensing under the GNU GPL.
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+****************************************************************************/
+/*!
+    \file pConsoleManagerParser.h
+    \brief Header of pConsoleManagerParser class
+*/
+
+#ifndef PCONSOLEMANAGERPARSER_H
+#define PCONSOLEMANAGERPARSER_H
+
+#include <MonkeyExport.h>
+
+#include "pConsoleManagerStep.h"
+
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QByteArray>
+
+class AbstractCommandParser;
+
+/*!
+    Parses the output of the commands executed by pConsoleManager out of the GUI thread.
+    
+    The console manager hands it the raw output as it is read, the thread decodes it
+    in lines and runs the command parsers on them. The steps found are collected and
+    made available by batches, stepsAvailable() being emitted once per batch.
+    The parsers are called from the thread, they must not be changed while a command runs.
+*/
+class Q_MONKEY_EXPORT pConsoleManagerParser : public QThread
+{
+    Q_OBJECT
+    
+public:
+    pConsoleManagerParser( QObject* parent = 0 );
+    virtual ~pConsoleManagerParser();
+    
+    void begin( const QList<AbstractCommandParser*>& parsers );
+    void appendData( const QByteArray& data );
+    void finish();
+    void stop();
+    pConsoleManagerStepList takeSteps();
+
+protected:
+    QMutex mMutex;
+    QWaitCondition mDataAvailable;
+    QWaitCondition mDataParsed;
+    QList<AbstractCommandParser*> mParsers;
+    QByteArray mData; // output not yet taken by the thread
+    bool mBegin;
+    bool mFinish;
+    bool mParsing;
+    bool mExit;
+    QByteArray mPending; // thread only, start of a line not yet ended
+    QMutex mStepsMutex;
+    pConsoleManagerStepList mSteps;
+    bool mStepsNotified;
+    
+    void parse( const QByteArray& data, bool finish, const QList<AbstractCommandParser*>& parsers );
+    void parseLines( QStringList& strings, const QList<AbstractCommandParser*>& parsers );
+    virtual void run();
+
+public slots:
+    void collectStep( const pConsoleManagerStep& step );
+    void collectSteps( const pConsoleManagerStepList& steps );
+
+signals:
+    void stepsAvailable();
+};
+
+#endif // PCONSOLEMANAGERPARSER_H
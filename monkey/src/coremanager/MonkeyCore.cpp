@@ -17,6 +17,7 @@
     Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
 ****************************************************************************/
 #include "coremanager/MonkeyCore.h"
+#include "coremanager/StartupProfiler.h"
 #include "main.h"
 #include "pMonkeyStudio.h"
 #include "settingsmanager/Settings.h"
@@ -42,6 +43,7 @@
 #include <pMenuBar.h>
 
 #include <QSplashScreen>
+#include <QTimer>
 #include <QPixmap>
 #include <QString>
 #include <QDate>
@@ -52,10 +54,18 @@ void showMessage( QSplashScreen* s, const QString& m )
     s->showMessage( m, Qt::AlignRight | Qt::AlignBottom, s->property( "isXMas" ).toBool() ? Qt::red : Qt::white );
 }
 
+void showPhase( QSplashScreen* s, const QString& m )
+{
+    StartupProfiler::setPhase( m );
+    showMessage( s, m );
+}
+
 QHash<const QMetaObject*, QObject*> MonkeyCore::mInstances;
 
 void MonkeyCore::init()
 {
+    StartupProfiler::setPhase( tr( "Creating Splashscreen..." ) );
+    
     // create splashscreen
     bool isXMas = false;
 
@@ -80,7 +90,7 @@ void MonkeyCore::init()
     splash.show();
 
     // restore application style
-    showMessage( &splash, tr( "Initializing Style..." ) );
+    showPhase( &splash, tr( "Initializing Style..." ) );
     qApp->setStyle( settings()->value( "MainWindow/Style", "system" ).toString() );
 
     // set default settings if first time running
@@ -90,7 +100,7 @@ void MonkeyCore::init()
     }
     
     // initialize locales
-    showMessage( &splash, tr( "Initializing locales..." ) );
+    showPhase( &splash, tr( "Initializing locales..." ) );
     TranslationManager* translationManager = MonkeyCore::translationsManager();
     translationManager->setFakeCLocaleEnabled( true );
     translationManager->addTranslationsMask( "qt*.qm" );
@@ -101,7 +111,7 @@ void MonkeyCore::init()
     translationManager->setTranslationsPaths( settings()->storagePaths( Settings::SP_TRANSLATIONS ) );
     
     // init translations
-    showMessage( &splash, tr( "Initializing Translations..." ) );
+    showPhase( &splash, tr( "Initializing Translations..." ) );
     if ( !settings()->value( "Translations/Accepted" ).toBool() )
     {
         const QString locale = TranslationDialog::getLocale( translationManager );
@@ -118,52 +128,56 @@ void MonkeyCore::init()
     translationManager->reloadTranslations();
 
     // init shortcuts editor
-    showMessage( &splash, tr( "Initializing Actions Manager..." ) );
+    showPhase( &splash, tr( "Initializing Actions Manager..." ) );
     MonkeyCore::actionsManager()->setSettings( settings() );
 
     // init shell && commands
-    showMessage( &splash, tr( "Initializing Shell..." ) );
+    showPhase( &splash, tr( "Initializing Shell..." ) );
     interpreter();
 
     // start console manager
-    showMessage( &splash, tr( "Initializing Console..." ) );
+    showPhase( &splash, tr( "Initializing Console..." ) );
     consoleManager();
 
     // init main window
-    showMessage( &splash, tr( "Initializing Main Window..." ) );
+    showPhase( &splash, tr( "Initializing Main Window..." ) );
     mainWindow()->initGui();
 
     // init abbreviations manager
-    showMessage( &splash, tr( "Initializing abbreviations manager..." ) );
+    showPhase( &splash, tr( "Initializing abbreviations manager..." ) );
     abbreviationsManager();
 
     // init file manager
-    showMessage( &splash, tr( "Initializing file manager..." ) );
+    showPhase( &splash, tr( "Initializing file manager..." ) );
     fileManager();
 
     // load mks scripts
-    showMessage( &splash, tr( "Executing scripts..." ) );
+    showPhase( &splash, tr( "Executing scripts..." ) );
     interpreter()->loadHomeScripts();
 
     // init pluginsmanager
-    showMessage( &splash, tr( "Initializing Plugins..." ) );
+    showPhase( &splash, tr( "Initializing Plugins..." ) );
     pluginsManager()->loadsPlugins();
 
     // restore window state
-    showMessage( &splash, tr( "Restoring Workspace..." ) );
+    showPhase( &splash, tr( "Restoring Workspace..." ) );
     mainWindow()->setSettings( settings() );
 
     // restore session
-    showMessage( &splash, tr( "Restoring Session..." ) );
+    showPhase( &splash, tr( "Restoring Session..." ) );
     if ( pMonkeyStudio::restoreSessionOnStartup() )
     {
         workspace()->fileSessionRestore_triggered();
     }
 
     // show main window
+    StartupProfiler::setPhase( tr( "Showing Main Window..." ) );
     mainWindow()->menu_Docks_aboutToShow();
     mainWindow()->show();
     mainWindow()->finalyzeGuiInit();
+    
+    // load the plugins not needed for the first frame
+    QTimer::singleShot( 0, pluginsManager(), SLOT( loadDeferredPlugins() ) );
 
     // ready
     showMessage( &splash, tr( "%1 v%2 (%3) Ready !" ).arg( PACKAGE_NAME, PACKAGE_VERSION, PACKAGE_VERSION_STR ) );
@@ -171,6 +185,9 @@ void MonkeyCore::init()
     // finish splashscreen
     splash.finish( mainWindow() );
 
+    // don't time the user interaction
+    StartupProfiler::setPhase( QString::null );
+    
     // show settings dialog the first time user start program
     if ( settings()->value( "FirstTimeRunning", true ).toBool() )
     {
@@ -182,7 +199,9 @@ void MonkeyCore::init()
     }
 
     // prepare apis
+    StartupProfiler::setPhase( tr( "Preparing APIs..." ) );
     pMonkeyStudio::prepareAPIs();
+    StartupProfiler::setPhase( QString::null );
 }
 
 Settings* MonkeyCore::settings()
@@ -0,0 +1,188 @@
+/****************************************************************************
+    Copyright (C) 2005 - 2011  Filipe AZEVEDO & The Monkey Studio Team
+    http://monkeystudio.org licensing under the GNU GPL.
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+****************************************************************************/
+#include "StartupProfiler.h"
+
+#include <QCoreApplication>
+#include <QFile>
+#include <QFileInfo>
+#include <QTextStream>
+
+bool StartupProfiler::mEnabled = false;
+QString StartupProfiler::mTraceFileName;
+QElapsedTimer StartupProfiler::mTimer;
+QList<StartupProfiler::Event> StartupProfiler::mEvents;
+QList<int> StartupProfiler::mOpenEvents;
+int StartupProfiler::mPhaseEvent = -1;
+
+void StartupProfiler::start( const QString& traceFileName )
+{
+    mEnabled = true;
+    mTraceFileName = traceFileName;
+    mEvents.clear();
+    mOpenEvents.clear();
+    mPhaseEvent = -1;
+    mTimer.start();
+}
+
+void StartupProfiler::finish()
+{
+    if ( !mEnabled ) {
+        return;
+    }
+    
+    // close the events still running
+    while ( !mOpenEvents.isEmpty() ) {
+        endEvent();
+    }
+    
+    mEnabled = false;
+    
+    qWarning( "%s", QCoreApplication::translate( "StartupProfiler", "Startup profile:" ).toLocal8Bit().constData() );
+    
+    qint64 total = 0;
+    
+    foreach ( const Event& event, mEvents ) {
+        const QString indent = QString( event.depth *2, QLatin1Char( ' ' ) );
+        
+        qWarning( "%10.2f ms  %s%s (%s)", event.duration /1000000.0, indent.toLocal8Bit().constData(), event.name.toLocal8Bit().constData(), event.category.toLocal8Bit().constData() );
+        
+        if ( event.depth == 0 ) {
+            total += event.duration;
+        }
+    }
+    
+    qWarning( "%10.2f ms  %s", total /1000000.0, QCoreApplication::translate( "StartupProfiler", "Total" ).toLocal8Bit().constData() );
+    
+    if ( writeTrace() ) {
+        qWarning( "%s", QCoreApplication::translate( "StartupProfiler", "Trace written to: %1" ).arg( QFileInfo( mTraceFileName ).absoluteFilePath() ).toLocal8Bit().constData() );
+    }
+    else {
+        qWarning( "%s", QCoreApplication::translate( "StartupProfiler", "Can't write trace: %1" ).arg( mTraceFileName ).toLocal8Bit().constData() );
+    }
+    
+    mEvents.clear();
+}
+
+void StartupProfiler::beginEvent( const QString& name, const char* category )
+{
+    if ( !mEnabled ) {
+        return;
+    }
+    
+    Event event;
+    event.name = name;
+    event.category = QString::fromLatin1( category );
+    event.start = elapsed();
+    event.duration = 0;
+    event.depth = mOpenEvents.count();
+    
+    mOpenEvents << mEvents.count();
+    mEvents << event;
+}
+
+void StartupProfiler::endEvent()
+{
+    if ( !mEnabled || mOpenEvents.isEmpty() ) {
+        return;
+    }
+    
+    Event& event = mEvents[ mOpenEvents.takeLast() ];
+    event.duration = elapsed() -event.start;
+}
+
+/*!
+    Ends the current phase and begins the phase \a name, a null name only ends the current phase.
+*/
+void StartupProfiler::setPhase( const QString& name )
+{
+    if ( !mEnabled ) {
+        return;
+    }
+    
+    if ( mPhaseEvent != -1 ) {
+        while ( mOpenEvents.contains( mPhaseEvent ) ) {
+            endEvent();
+        }
+        
+        mPhaseEvent = -1;
+    }
+    
+    if ( !name.isNull() ) {
+        mPhaseEvent = mEvents.count();
+        beginEvent( name, "phase" );
+    }
+}
+
+qint64 StartupProfiler::elapsed()
+{
+#if QT_VERSION >= 0x040800
+    return mTimer.nsecsElapsed();
+#else
+    return mTimer.elapsed() *1000000;
+#endif
+}
+
+QString StartupProfiler::escaped( const QString& string )
+{
+    QString result;
+    result.reserve( string.length() );
+    
+    foreach ( const QChar& c, string ) {
+        if ( c == QLatin1Char( '"' ) || c == QLatin1Char( '\\' ) ) {
+            result.append( QLatin1Char( '\\' ) ).append( c );
+        }
+        else if ( c.unicode() < 0x20 ) {
+            result.append( QString( "\\u%1" ).arg( c.unicode(), 4, 16, QLatin1Char( '0' ) ) );
+        }
+        else {
+            result.append( c );
+        }
+    }
+    
+    return result;
+}
+
+bool StartupProfiler::writeTrace()
+{
+    QFile file( mTraceFileName );
+    
+    if ( !file.open( QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text ) ) {
+        return false;
+    }
+    
+    const qint64 pid = QCoreApplication::applicationPid();
+    QTextStream stream( &file );
+    stream.setCodec( "UTF-8" );
+    
+    // complete events, timestamps are in microseconds
+    stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    
+    for ( int i = 0; i < mEvents.count(); i++ ) {
+        const Event& event = mEvents.at( i );
+        
+        stream << QString( "{\"name\":\"%1\",\"cat\":\"%2\",\"ph\":\"X\",\"ts\":%3,\"dur\":%4,\"pid\":%5,\"tid\":1}" )
+            .arg( escaped( event.name ), escaped( event.category ), QString::number( event.start /1000.0, 'f', 3 ), QString::number( event.duration /1000.0, 'f', 3 ), QString::number( pid ) );
+        stream << ( i < mEvents.count() -1 ? ",\n" : "\n" );
+    }
+    
+    stream << "]}\n";
+    stream.flush();
+    
+    return file.error() == QFile::NoError;
+}
@@ -0,0 +1,89 @@
+/****************************************************************************
+    Copyright (C) 2005 - 2011  Filipe AZEVEDO & The Monkey Studio Team
+    http://monkeystudio.org licensing under the GNU GPL.
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+****************************************************************************/
+#ifndef STARTUPPROFILER_H
+#define STARTUPPROFILER_H
+
+#include <MonkeyExport.h>
+
+#include <QString>
+#include <QList>
+#include <QElapsedTimer>
+
+/*
+    Times the startup phases and the plugins installation.
+    It does nothing until start() is called (--profile-startup command line switch),
+    finish() writes a Chrome trace (chrome://tracing) and print a summary.
+*/
+class Q_MONKEY_EXPORT StartupProfiler
+{
+public:
+    // times the lifetime of the scope
+    class Scope
+    {
+    public:
+        Scope( const QString& name, const char* category )
+            : mActive( StartupProfiler::isEnabled() )
+        {
+            if ( mActive ) {
+                StartupProfiler::beginEvent( name, category );
+            }
+        }
+        
+        ~Scope()
+        {
+            if ( mActive ) {
+                StartupProfiler::endEvent();
+            }
+        }
+    
+    protected:
+        bool mActive;
+    };
+    
+    static void start( const QString& traceFileName );
+    static void finish();
+    static inline bool isEnabled() { return mEnabled; }
+    
+    static void beginEvent( const QString& name, const char* category );
+    static void endEvent();
+    static void setPhase( const QString& name );
+
+protected:
+    struct Event
+    {
+        QString name;
+        QString category;
+        qint64 start;
+        qint64 duration;
+        int depth;
+    };
+    
+    static bool mEnabled;
+    static QString mTraceFileName;
+    static QElapsedTimer mTimer;
+    static QList<Event> mEvents;
+    static QList<int> mOpenEvents;
+    static int mPhaseEvent;
+    
+    static qint64 elapsed();
+    static QString escaped( const QString& string );
+    static bool writeTrace();
+};
+
+#endif // STARTUPPROFILER_H
@@ -30,6 +30,7 @@
 #include "pluginsmanager/PluginsManager.h"
 #include "settingsmanager/Settings.h"
 #include "commandlinemanager/CommandLineManager.h"
+#include "coremanager/StartupProfiler.h"
 
 //#include "properties/Properties.h"
 
@@ -71,12 +72,36 @@ int main( int argc, char** argv )
         return 0;
     }
 
+    // replay build logs through the parsers, no gui needed
+    if ( arguments.contains( "-benchmark-parsers" ) )
+    {
+        const int result = clm.benchmarkParsers( clm.arguments().value( "-benchmark-parsers" ) );
+        delete MonkeyCore::settings();
+        return result;
+    }
+
+    // index source trees, no gui needed
+    if ( arguments.contains( "-benchmark-indexer" ) )
+    {
+        const int result = clm.benchmarkIndexer( clm.arguments().value( "-benchmark-indexer" ) );
+        delete MonkeyCore::settings();
+        return result;
+    }
+
+    // time the startup if requested
+    if ( arguments.contains( "--profile-startup" ) )
+    {
+        StartupProfiler::start( clm.arguments().value( "--profile-startup" ).value( 0 ) );
+    }
+
     // init monkey studio core
     MonkeyCore::init();
     // handle command line arguments
     clm.process();
     // execute application
     const int result = a.exec();
+    // write the startup profile
+    StartupProfiler::finish();
     // some cleanup
     MonkeyCore::pluginsManager()->clearPlugins();
     delete MonkeyCore::settings();
@@ -24,6 +24,7 @@
 
 #include "workspace/pAbstractChild.h"
 #include "qscintillamanager/pEditor.h"
+#include "qscintillamanager/pAPIs.h"
 
 #include <pQueuedMessageToolBar.h>
 
@@ -73,7 +74,7 @@
 #include <QDebug>
 
 QHash<QString,QsciLexer*> mGlobalsLexers;
-QHash<QString,QsciAPIs*> mGlobalsAPIs;
+QHash<QString,pAPIs*> mGlobalsAPIs;
 
 bool insensitiveStringLesserThan( const QString& left, const QString& right )
 {
@@ -344,33 +345,36 @@ QString pMonkeyStudio::scintillaSettingsPath()
 */
 void pMonkeyStudio::prepareAPIs()
 {
-    // check lexers & apis
-    if ( mGlobalsLexers.isEmpty() || mGlobalsAPIs.isEmpty() )
+    // only the apis already in use are refreshed, the others are prepared when a document needs them
+    foreach ( QsciLexer* l, mGlobalsLexers )
     {
-        // free hashes
-        qDeleteAll( mGlobalsLexers );
-        mGlobalsLexers.clear();
-        qDeleteAll( mGlobalsAPIs );
-        mGlobalsAPIs.clear();
+        if ( mGlobalsAPIs.contains( l->language() ) && mGlobalsAPIs[ l->language() ]->hasSources() )
+            prepareAPIs( l );
     }
+}
+
+/*!
+    \details Prepare the apis of the given \c lexer from the api files configured for its language.
+    \details Nothing is done if they are already prepared from the same files, else the prepared informations are
+    \details read from the cache when the files didn't change, or prepared in the background.
+    \param lexer The lexer to prepare apis for
+*/
+void pMonkeyStudio::prepareAPIs( QsciLexer* lexer )
+{
+    // cancel if no lexer
+    if ( !lexer )
+        return;
+    // get apis
+    pAPIs* a = qobject_cast<pAPIs*>( apisForLexer( lexer ) );
     // get monkey status bar
     pQueuedMessageToolBar* sbar = MonkeyCore::messageManager();
-    // iterate each language
-    foreach ( QString ln, availableLanguages() )
-    {
-        QsciLexer* l = lexerForLanguage( ln );
-        QsciAPIs* a = apisForLexer( l );
-        // clear raw api
-        a->clear();
-        // load prepared files
-        foreach ( QString f, MonkeyCore::settings()->value( QString( "SourceAPIs/" ).append( ln ) ).toStringList() )
-        {
-            if ( !a->load( QDir::isRelativePath( f ) ? qApp->applicationDirPath().append( "/%1" ).arg( f ) : f ) )
-                sbar->appendMessage( QObject::tr( "Can't load api file: '%1'" ).arg( QFileInfo( f ).fileName() ) );
-        }
-        // start prepare for apis
-        a->prepare();
-    }
+    // get raw api files
+    QStringList files;
+    foreach ( QString f, MonkeyCore::settings()->value( QString( "SourceAPIs/" ).append( lexer->language() ) ).toStringList() )
+        files << ( QDir::isRelativePath( f ) ? qApp->applicationDirPath().append( "/%1" ).arg( f ) : f );
+    // prepare them
+    foreach ( const QString& f, a->prepareFiles( files ) )
+        sbar->appendMessage( QObject::tr( "Can't load api file: '%1'" ).arg( QFileInfo( f ).fileName() ) );
 }
 
 /*!
@@ -386,7 +390,7 @@ QsciAPIs* pMonkeyStudio::apisForLexer( QsciLexer* lexer )
     if ( !mGlobalsAPIs.contains( lexer->language() ) )
     {
         // create apis
-        QsciAPIs* apis = new QsciAPIs( lexer );
+        pAPIs* apis = new pAPIs( lexer );
         // store global apis
         mGlobalsAPIs[lexer->language()] = apis;
     }
@@ -75,6 +75,7 @@ namespace pMonkeyStudio
     Q_MONKEY_EXPORT QString settingsPath();
     Q_MONKEY_EXPORT QString scintillaSettingsPath();
     Q_MONKEY_EXPORT void prepareAPIs();
+    Q_MONKEY_EXPORT void prepareAPIs( QsciLexer* lexer );
     Q_MONKEY_EXPORT QsciAPIs* apisForLexer( QsciLexer* lexer );
     Q_MONKEY_EXPORT QString languageForFileName( const QString& fileName );
     Q_MONKEY_EXPORT QsciLexer* lexerForFileName( const QString& fileName );
@@ -18,6 +18,7 @@
 ****************************************************************************/
 #include "pluginsmanager/BasePlugin.h"
 #include "pluginsmanager/PluginsManager.h"
+#include "coremanager/StartupProfiler.h"
 #include "main.h"
 
 #include <QApplication>
@@ -99,6 +100,7 @@ bool BasePlugin::setEnabled( bool enabled )
 {
     if ( enabled && !isEnabled() )
     {
+        StartupProfiler::Scope scope( QString( "%1::install()" ).arg( infos().Name ), "plugin" );
         stateAction()->setChecked( install() );
         return stateAction()->isChecked();
     }
@@ -62,6 +62,7 @@ public:
             Type = BasePlugin::iBase;
             FirstStartEnabled = false;
             HaveSettingsWidget = false;
+            DeferredLoading = false;
             Pixmap = pIconManager::pixmap( "monkey2.png", ":/application" );
             ApplicationVersionRequired = PACKAGE_VERSION;
         }
@@ -79,6 +80,7 @@ public:
         QPixmap Pixmap; // plugin icon
         QString ApplicationVersionRequired; // the minimum mks version this plugin require, plugin must not enable itself if minimum version is not reached !
         QStringList dependencies; // the plugin to enable as dependency for this plugin
+        bool DeferredLoading; // plugin not needed for the first frame, it can be loaded once the main window is shown
     };
     
     BasePlugin();
@@ -21,11 +21,15 @@
 #include "pMonkeyStudio.h"
 #include "ui/UIPluginsSettings.h"
 #include "coremanager/MonkeyCore.h"
+#include "maininterface/UIMain.h"
+#include "coremanager/StartupProfiler.h"
 #include "main.h"
 
 #include <pVersion.h>
 
 #include <QPluginLoader>
+#include <QElapsedTimer>
+#include <QTimer>
 
 #include <QDebug>
 
@@ -33,13 +37,32 @@ PluginsManager::PluginsManager( QObject* p )
     : QObject( p )
 {
     mMenuHandler = new PluginsMenu( this );
+    mDeferredPluginsLoaded = false;
 }
 
 QList<BasePlugin*> PluginsManager::plugins() const
-{ return mPlugins; }
+{
+    if ( !mPendingPlugins.isEmpty() ) {
+        const_cast<PluginsManager*>( this )->loadPendingPlugins();
+    }
+    
+    return mPlugins;
+}
 
 void PluginsManager::loadsPlugins()
 {
+    QElapsedTimer timer;
+    timer.start();
+    
+    // the libraries not changed since the previous run are known from their manifest,
+    // the disabled plugins and the ones not needed for the first frame are not loaded now
+    const QHash<QString, PluginManifest> manifests = MonkeyCore::settings()->value( "FirstTimeRunning", true ).toBool()
+        ? QHash<QString, PluginManifest>()
+        : readManifests();
+    
+    mManifests.clear();
+    mPendingPlugins.clear();
+    
     // loads static plugins
     foreach ( QObject* o, QPluginLoader::staticInstances() )
         if ( !addPlugin( o ) )
@@ -60,27 +83,147 @@ void PluginsManager::loadsPlugins()
             if ( f.absoluteFilePath().contains( "/qt/" ) )
                 continue;
 #endif
-            // load plugin
-            QPluginLoader l( f.absoluteFilePath() );
-            // try unload it and reload it in case of old one in memory
-            if ( !l.instance() )
+            // defer plugin
+            const PluginManifest manifest = manifests.value( f.absoluteFilePath() );
+            if ( !manifest.Name.isEmpty() && manifest.LastModified == f.lastModified() && ( manifest.DeferredLoading || !isUserEnabled( manifest.Name ) ) )
             {
-                l.unload();
-                l.load();
-            }
-            // continue on no plugin
-            if ( !l.instance() )
-            {
-                qWarning("%s", tr( "Failed to load plugin ( %1 ): Error: %2" ).arg( f.absoluteFilePath(), l.errorString() ).toLocal8Bit().constData() );
+                mManifests[ manifest.FileName ] = manifest;
+                mPendingPlugins << manifest;
                 continue;
             }
-            // try to add plugin to plugins list, else unload it
-            else if ( !addPlugin( l.instance() ) )
-                l.unload();
+            // load plugin
+            loadLibrary( f );
         }
     }
     // installs user requested plugins
     enableUserPlugins();
+    // remember the libraries for the next run, the child plugins suffixes are set once installed
+    writeManifests();
+    
+    qWarning( "%s", tr( "Plugins loaded in %1 ms: %2 loaded, %3 pending" ).arg( timer.elapsed() ).arg( mPlugins.count() ).arg( mPendingPlugins.count() ).toLocal8Bit().constData() );
+}
+
+BasePlugin* PluginsManager::loadLibrary( const QFileInfo& file )
+{
+    StartupProfiler::Scope scope( file.fileName(), "library" );
+    // load plugin
+    QPluginLoader l( file.absoluteFilePath() );
+    // try unload it and reload it in case of old one in memory
+    if ( !l.instance() )
+    {
+        l.unload();
+        l.load();
+    }
+    // continue on no plugin
+    if ( !l.instance() )
+    {
+        qWarning("%s", tr( "Failed to load plugin ( %1 ): Error: %2" ).arg( file.absoluteFilePath(), l.errorString() ).toLocal8Bit().constData() );
+        return 0;
+    }
+    // try to add plugin to plugins list, else unload it
+    else if ( !addPlugin( l.instance() ) )
+    {
+        l.unload();
+        return 0;
+    }
+    
+    BasePlugin* bp = qobject_cast<BasePlugin*>( l.instance() );
+    PluginManifest manifest;
+    
+    manifest.FileName = file.absoluteFilePath();
+    manifest.LastModified = file.lastModified();
+    manifest.Name = bp->infos().Name;
+    manifest.Type = bp->infos().Type;
+    manifest.Version = bp->infos().Version;
+    manifest.dependencies = bp->infos().dependencies;
+    manifest.DeferredLoading = bp->infos().DeferredLoading;
+    mManifests[ manifest.FileName ] = manifest;
+    
+    return bp;
+}
+
+/*!
+    Load the pending libraries that can answer a plugins lookup, their dependencies first.
+    Only the libraries named \a name, or implementing the \a type interface for an unnamed lookup, are loaded;
+    an unnamed lookup of any plugin type leaves the others to loadDeferredPlugins().
+    Once loaded, the plugins are enabled according to the user settings.
+*/
+void PluginsManager::loadPendingPlugins( PluginsManager::StateType state, const QString& name, BasePlugin::Type type )
+{
+    QList<PluginManifest> manifests;
+    
+    // take them first, enabling a plugin can lookup other plugins
+    for ( int i = mPendingPlugins.count() -1; i >= 0; i-- )
+    {
+        const PluginManifest& manifest = mPendingPlugins.at( i );
+        
+        const bool matches = name.isEmpty()
+            ? type != BasePlugin::iBase && manifest.Type.testFlag( type )
+            : manifest.Name == name;
+        
+        if ( matches && ( state != stEnabled || isUserEnabled( manifest.Name ) ) )
+        {
+            manifests.prepend( mPendingPlugins.takeAt( i ) );
+        }
+    }
+    
+    if ( manifests.isEmpty() )
+    {
+        return;
+    }
+    
+    foreach ( const PluginManifest& manifest, manifests )
+    {
+        foreach ( const QString& dependency, manifest.dependencies )
+        {
+            loadPendingPlugins( stAll, dependency, BasePlugin::iBase );
+        }
+        
+        BasePlugin* bp = loadLibrary( QFileInfo( manifest.FileName ) );
+        
+        if ( bp )
+        {
+            enableUserPlugin( bp );
+        }
+        else
+        {
+            mManifests.remove( manifest.FileName );
+        }
+    }
+    
+    writeManifests();
+}
+
+void PluginsManager::loadPendingPlugins()
+{
+    while ( !mPendingPlugins.isEmpty() )
+    {
+        loadPendingPlugins( stAll, mPendingPlugins.first().Name, BasePlugin::iBase );
+    }
+}
+
+/*!
+    Load the enabled plugins not needed for the first frame, one by event loop iteration.
+    The main window state is restored again at the end for their docks.
+*/
+void PluginsManager::loadDeferredPlugins()
+{
+    foreach ( const PluginManifest& manifest, mPendingPlugins )
+    {
+        if ( isUserEnabled( manifest.Name ) )
+        {
+            loadPendingPlugins( stEnabled, manifest.Name, BasePlugin::iBase );
+            mDeferredPluginsLoaded = true;
+            QTimer::singleShot( 0, this, SLOT( loadDeferredPlugins() ) );
+            return;
+        }
+    }
+    
+    if ( mDeferredPluginsLoaded )
+    {
+        mDeferredPluginsLoaded = false;
+        MonkeyCore::mainWindow()->restoreState();
+    }
 }
 
 bool PluginsManager::addPlugin( QObject* o )
@@ -136,44 +279,135 @@ void PluginsManager::enableUserPlugins()
 {
     foreach ( BasePlugin* bp, mPlugins )
     {
-        // check first start state
-        if ( MonkeyCore::settings()->value( "FirstTimeRunning", true ).toBool() )
+        enableUserPlugin( bp );
+    }
+}
+
+void PluginsManager::enableUserPlugin( BasePlugin* bp )
+{
+    // check first start state
+    if ( MonkeyCore::settings()->value( "FirstTimeRunning", true ).toBool() )
+    {
+        if ( !bp->infos().FirstStartEnabled )
         {
-            if ( !bp->infos().FirstStartEnabled )
-            {
-                MonkeyCore::settings()->setValue( QString( "Plugins/%1" ).arg( bp->infos().Name ), false );
-            }
+            MonkeyCore::settings()->setValue( QString( "Plugins/%1" ).arg( bp->infos().Name ), false );
         }
-        
-        // check in settings if we must install this plugin
-        if ( !MonkeyCore::settings()->value( QString( "Plugins/%1" ).arg( bp->infos().Name ), true ).toBool() )
+    }
+    
+    // check in settings if we must install this plugin
+    if ( !MonkeyCore::settings()->value( QString( "Plugins/%1" ).arg( bp->infos().Name ), true ).toBool() )
+    {
+        qWarning("%s", tr( "User wantn't to intall plugin: %1" ).arg( bp->infos().Name ).toLocal8Bit().constData() );
+    }
+    // if not enabled, enable it
+    else if ( !bp->isEnabled() )
+    {
+        if ( bp->setEnabled( true ) )
         {
-            qWarning("%s", tr( "User wantn't to intall plugin: %1" ).arg( bp->infos().Name ).toLocal8Bit().constData() );
+            qWarning("%s", tr( "Successfully enabled plugin: %1" ).arg( bp->infos().Name ).toLocal8Bit().constData() );
         }
-        // if not enabled, enable it
-        else if ( !bp->isEnabled() )
+        else
         {
-            if ( bp->setEnabled( true ) )
-            {
-                qWarning("%s", tr( "Successfully enabled plugin: %1" ).arg( bp->infos().Name ).toLocal8Bit().constData() );
-            }
-            else
-            {
-                qWarning("%s", tr( "Unsuccessfully enabled plugin: %1" ).arg( bp->infos().Name ).toLocal8Bit().constData() );
-            }
+            qWarning("%s", tr( "Unsuccessfully enabled plugin: %1" ).arg( bp->infos().Name ).toLocal8Bit().constData() );
         }
-        else
+    }
+    else
+    {
+        qWarning("%s", tr( "Already enabled plugin: %1" ).arg( bp->infos().Name ).toLocal8Bit().constData() );
+    }
+}
+
+bool PluginsManager::isUserEnabled( const QString& name ) const
+{
+    return MonkeyCore::settings()->value( QString( "Plugins/%1" ).arg( name ), true ).toBool();
+}
+
+QHash<QString, PluginsManager::PluginManifest> PluginsManager::readManifests() const
+{
+    QHash<QString, PluginManifest> manifests;
+    Settings* settings = MonkeyCore::settings();
+    const int count = settings->beginReadArray( "PluginsManifests" );
+    
+    for ( int i = 0; i < count; i++ )
+    {
+        settings->setArrayIndex( i );
+        
+        PluginManifest manifest;
+        manifest.FileName = settings->value( "FileName" ).toString();
+        manifest.LastModified = settings->value( "LastModified" ).toDateTime();
+        manifest.Name = settings->value( "Name" ).toString();
+        manifest.Type = BasePlugin::Types( settings->value( "Type" ).toInt() );
+        manifest.Version = settings->value( "Version" ).toString();
+        manifest.dependencies = settings->value( "Dependencies" ).toStringList();
+        manifest.DeferredLoading = settings->value( "DeferredLoading" ).toBool();
+        manifest.Suffixes = settings->value( "Suffixes" ).toStringList();
+        manifests[ manifest.FileName ] = manifest;
+    }
+    
+    settings->endArray();
+    
+    return manifests;
+}
+
+void PluginsManager::writeManifests() const
+{
+    Settings* settings = MonkeyCore::settings();
+    int i = 0;
+    
+    settings->remove( "PluginsManifests" );
+    settings->beginWriteArray( "PluginsManifests" );
+    
+    foreach ( const PluginManifest& manifest, mManifests )
+    {
+        QStringList suffixes = manifest.Suffixes;
+        
+        // an enabled child plugin gives its current suffixes
+        foreach ( BasePlugin* bp, mPlugins )
         {
-            qWarning("%s", tr( "Already enabled plugin: %1" ).arg( bp->infos().Name ).toLocal8Bit().constData() );
+            ChildPlugin* cp = dynamic_cast<ChildPlugin*>( bp );
+            
+            if ( cp && bp->isEnabled() && bp->infos().Name == manifest.Name )
+            {
+                suffixes.clear();
+                
+                foreach ( const QStringList& patterns, cp->suffixes() )
+                {
+                    suffixes << patterns;
+                }
+            }
         }
+        
+        settings->setArrayIndex( i++ );
+        settings->setValue( "FileName", manifest.FileName );
+        settings->setValue( "LastModified", manifest.LastModified );
+        settings->setValue( "Name", manifest.Name );
+        settings->setValue( "Type", int( manifest.Type ) );
+        settings->setValue( "Version", manifest.Version );
+        settings->setValue( "Dependencies", manifest.dependencies );
+        settings->setValue( "DeferredLoading", manifest.DeferredLoading );
+        settings->setValue( "Suffixes", suffixes );
     }
+    
+    settings->endArray();
 }
 
 pAbstractChild* PluginsManager::documentForFileName( const QString& fileName )
 {
-    foreach ( ChildPlugin* plugin, plugins<ChildPlugin*>( PluginsManager::stEnabled ) )
+    // only the pending child plugins opening this file are loaded, a copy as loading takes them
+    const QList<PluginManifest> manifests = mPendingPlugins;
+    
+    foreach ( const PluginManifest& manifest, manifests )
+    {
+        if ( manifest.Type.testFlag( BasePlugin::iChild ) && QDir::match( manifest.Suffixes, fileName ) && isUserEnabled( manifest.Name ) )
+        {
+            loadPendingPlugins( stEnabled, manifest.Name, BasePlugin::iBase );
+        }
+    }
+    
+    foreach ( BasePlugin* bp, mPlugins )
     {
-        pAbstractChild* document = plugin->createDocument( fileName );
+        ChildPlugin* plugin = dynamic_cast<ChildPlugin*>( bp );
+        pAbstractChild* document = plugin && bp->isEnabled() ? plugin->createDocument( fileName ) : 0;
         
         if ( document )
         {
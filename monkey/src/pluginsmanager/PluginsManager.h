@@ -26,10 +26,22 @@
 #include "DebuggerPlugin.h"
 #include "pluginsmanager/CLIToolPlugin.h"
 
+#include <QDateTime>
+#include <QHash>
+
 class XUPItem;
+class XUPPlugin;
+class QFileInfo;
 class pAbstractChild;
 class PluginsMenu;
 
+// the plugin type implementing an interface, iBase when any plugin can implement it
+template <class T> inline BasePlugin::Type pluginInterfaceType() { return BasePlugin::iBase; }
+template <> inline BasePlugin::Type pluginInterfaceType<ChildPlugin*>() { return BasePlugin::iChild; }
+template <> inline BasePlugin::Type pluginInterfaceType<CLIToolPlugin*>() { return BasePlugin::iCLITool; }
+template <> inline BasePlugin::Type pluginInterfaceType<DebuggerPlugin*>() { return BasePlugin::iDebugger; }
+template <> inline BasePlugin::Type pluginInterfaceType<XUPPlugin*>() { return BasePlugin::iXUP; }
+
 class Q_MONKEY_EXPORT PluginsManager : public QObject
 {
     Q_OBJECT
@@ -39,6 +51,25 @@ class Q_MONKEY_EXPORT PluginsManager : public QObject
     
 public:
     enum StateType { stAll = -1, stDisabled, stEnabled };
+    
+    // what is known of a plugin library without loading it, cached from a run to the next one
+    struct PluginManifest
+    {
+        PluginManifest()
+        {
+            Type = BasePlugin::iBase;
+            DeferredLoading = false;
+        }
+        
+        QString FileName; // the library absolute file path
+        QDateTime LastModified; // the library modification time when the manifest was read
+        QString Name;
+        BasePlugin::Types Type;
+        QString Version;
+        QStringList dependencies;
+        bool DeferredLoading;
+        QStringList Suffixes; // the files opened by a child plugin, ie: *.ui, known once it was enabled
+    };
 
     void loadsPlugins();
     
@@ -48,6 +79,10 @@ public:
     {
         QList<T> plugins;
         
+        if ( !mPendingPlugins.isEmpty() ) {
+            loadPendingPlugins( state, name, pluginInterfaceType<T>() );
+        }
+        
         foreach ( BasePlugin* bp, mPlugins ) {
             // plugin state
             if ( state == stAll || ( !bp->isEnabled() && state == stDisabled ) || ( bp->isEnabled() && state == stEnabled ) ) {
@@ -85,14 +120,25 @@ public:
 protected:
     PluginsMenu* mMenuHandler;
     QList<BasePlugin*> mPlugins;
+    QHash<QString, PluginsManager::PluginManifest> mManifests; // the loaded or pending libraries manifests by file path
+    QList<PluginsManager::PluginManifest> mPendingPlugins; // the libraries not loaded yet
+    bool mDeferredPluginsLoaded;
 
     PluginsManager( QObject* = 0 );
     bool addPlugin( QObject* );
+    BasePlugin* loadLibrary( const QFileInfo& file );
+    void loadPendingPlugins( PluginsManager::StateType state, const QString& name, BasePlugin::Type type );
     void enableUserPlugins();
+    void enableUserPlugin( BasePlugin* plugin );
+    bool isUserEnabled( const QString& name ) const;
+    QHash<QString, PluginsManager::PluginManifest> readManifests() const;
+    void writeManifests() const;
     
 public slots:
     void manageRequested();
     void clearPlugins();
+    void loadPendingPlugins();
+    void loadDeferredPlugins();
 };
 
 #endif // PLUGINSMANAGER_H
@@ -56,6 +56,8 @@ void PluginsMenu::setMenu( QMenu* menu )
     mMenu->addSeparator();
     
     connect( mManageDialogAction, SIGNAL( triggered() ), mManager, SLOT( manageRequested() ) );
+    // the plugins not loaded on startup are listed once the user looks at them
+    connect( mMenu, SIGNAL( aboutToShow() ), mManager, SLOT( loadPendingPlugins() ) );
 }
 
 void PluginsMenu::initPluginMenusActions( BasePlugin* plugin, BasePlugin::Type type )
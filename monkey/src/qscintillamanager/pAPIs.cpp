@@ -0,0 +1,135 @@
+/****************************************************************************
+    Copyright (C) 2005 - 2011  Filipe AZEVEDO & The Monkey Studio Team
+    http://monkeystudio.org licensing under the GNU GPL.
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+****************************************************************************/
+#include "pAPIs.h"
+#include "coremanager/MonkeyCore.h"
+#include "settingsmanager/Settings.h"
+
+#include <qscilexer.h>
+
+#include <QCryptographicHash>
+#include <QFileInfo>
+#include <QDateTime>
+#include <QDir>
+
+pAPIs::pAPIs( QsciLexer* lexer )
+    : QsciAPIs( lexer )
+{
+    connect( this, SIGNAL( apiPreparationFinished() ), this, SLOT( preparationFinished() ) );
+}
+
+/*!
+    Returns true once raw api files were given to prepareFiles()
+*/
+bool pAPIs::hasSources() const
+{
+    return !mKey.isEmpty();
+}
+
+/*!
+    Prepare the given raw api files, unless they are already.
+    The prepared informations are loaded from the cache if they are there, else they are prepared
+    in the background and saved in the cache once done.
+    \param fileNames The absolute file paths of the raw api files
+    \return The files that can't be loaded
+*/
+QStringList pAPIs::prepareFiles( const QStringList& fileNames )
+{
+    const QString key = cacheKey( fileNames );
+    QStringList failed;
+    
+    if ( key == mKey ) {
+        return failed;
+    }
+    
+    cancelPreparation();
+    mKey = key;
+    mCacheFilePath = QString( "%1/%2%3.pap" ).arg( MonkeyCore::settings()->homePath( Settings::SP_APIS ) ).arg( cacheFilePrefix() ).arg( key );
+    
+    if ( isPrepared( mCacheFilePath ) && loadPrepared( mCacheFilePath ) ) {
+        mCacheFilePath.clear();
+        return failed;
+    }
+    
+    clear();
+    
+    foreach ( const QString& fileName, fileNames ) {
+        if ( !load( fileName ) ) {
+            failed << fileName;
+        }
+    }
+    
+    // don't cache incomplete informations
+    if ( !failed.isEmpty() ) {
+        mCacheFilePath.clear();
+    }
+    
+    prepare();
+    
+    return failed;
+}
+
+QString pAPIs::cacheKey( const QStringList& fileNames ) const
+{
+    QCryptographicHash hash( QCryptographicHash::Md5 );
+    
+    hash.addData( QSCINTILLA_VERSION_STR );
+    
+    foreach ( const QString& fileName, fileNames ) {
+        const QFileInfo file( fileName );
+        
+        hash.addData( file.absoluteFilePath().toUtf8() );
+        hash.addData( QByteArray::number( file.size() ) );
+        hash.addData( QByteArray::number( file.lastModified().toMSecsSinceEpoch() ) );
+    }
+    
+    return QString::fromLatin1( hash.result().toHex() );
+}
+
+QString pAPIs::cacheFilePrefix() const
+{
+    QString language = QString::fromLatin1( lexer()->language() );
+    
+    for ( int i = 0; i < language.length(); i++ ) {
+        if ( !language.at( i ).isLetterOrNumber() ) {
+            language[ i ] = QLatin1Char( '_' );
+        }
+    }
+    
+    return language.append( QLatin1Char( '-' ) );
+}
+
+void pAPIs::preparationFinished()
+{
+    if ( mCacheFilePath.isEmpty() ) {
+        return;
+    }
+    
+    // drop the informations prepared for older versions of the files
+    const QFileInfo cache( mCacheFilePath );
+    QDir dir = cache.absoluteDir();
+    
+    foreach ( const QString& fileName, dir.entryList( QStringList( QString( "%1*.pap" ).arg( cacheFilePrefix() ) ), QDir::Files ) ) {
+        if ( fileName != cache.fileName() ) {
+            dir.remove( fileName );
+        }
+    }
+    
+    savePrepared( mCacheFilePath );
+    mCacheFilePath.clear();
+}
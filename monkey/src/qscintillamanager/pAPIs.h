@@ -0,0 +1,53 @@
+/****************************************************************************
+    Copyright (C) 2005 - 2011  Filipe AZEVEDO & The Monkey Studio Team
+    http://monkeystudio.org licensing under the GNU GPL.
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+****************************************************************************/
+#ifndef PAPIS_H
+#define PAPIS_H
+
+#include <MonkeyExport.h>
+#include <qsciapis.h>
+
+#include <QStringList>
+
+/*
+    QsciAPIs keeping its prepared informations in a disk cache.
+    The cache is keyed by the raw api files and their modification times, so an unchanged
+    set of files is loaded back with a single read instead of being prepared again.
+*/
+class Q_MONKEY_EXPORT pAPIs : public QsciAPIs
+{
+    Q_OBJECT
+
+public:
+    pAPIs( QsciLexer* lexer );
+    
+    bool hasSources() const;
+    QStringList prepareFiles( const QStringList& fileNames );
+
+protected:
+    QString mKey; // key of the raw files currently prepared or being prepared
+    QString mCacheFilePath; // where to save the informations being prepared, empty if they must not be
+    
+    QString cacheKey( const QStringList& fileNames ) const;
+    QString cacheFilePrefix() const;
+
+protected slots:
+    void preparationFinished();
+};
+
+#endif // PAPIS_H
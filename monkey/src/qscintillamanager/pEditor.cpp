@@ -486,6 +486,7 @@ bool pEditor::openFile( const QString& fileName, const QString& codec )
 
     // set lexer and apis
     setLexer( pMonkeyStudio::lexerForFileName( fileName ) );
+    pMonkeyStudio::prepareAPIs( lexer() );
 
     // set properties
     pMonkeyStudio::setEditorProperties( this );
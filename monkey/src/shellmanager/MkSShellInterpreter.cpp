@@ -19,14 +19,21 @@
 #include "shellmanager/MkSShellInterpreter.h"
 #include "coremanager/MonkeyCore.h"
 #include "settingsmanager/Settings.h"
+#include "main.h"
 
 #include <pQueuedMessageToolBar.h>
 
 #include <QFileInfo>
 #include <QDir>
+#include <QDataStream>
+#include <QDateTime>
 #include <QDebug>
 
 const QString MkSShell_DirName = "mks_scripts";
+// compiled home scripts are stored next to their source as <script>c, ie: parsers.mks -> parsers.mksc
+// the commands kept depend on the validators of the running version, which is part of the header
+const quint32 MkSShell_CompiledMagic = 0x4D4B5343; // MKSC
+const qint32 MkSShell_CompiledVersion = 2;
 QPointer<MkSShellInterpreter> MkSShellInterpreter::mInstance = 0;
 
 QString MkSShellInterpreter::interpretHelp( const QString& command, const QStringList& arguments, int* result, MkSShellInterpreter* interpreter, void* data )
@@ -106,8 +113,67 @@ MkSShellInterpreter::MkSShellInterpreter( QObject* parent )
     addCommandImplementation( "echo", interpretEcho, tr( "Print back arguments" ), this );
 }
 
-bool MkSShellInterpreter::loadScript( const QString& fileName )
+/*!
+    Return the compiled script file of \a fileName, or a null string if the script is not cached.
+    Only the home scripts are cached, the application never writes next to the other scripts.
+*/
+QString MkSShellInterpreter::compiledFileName( const QString& fileName )
+{
+    const QFileInfo info( fileName );
+    const QDir home( MonkeyCore::settings()->homePath( Settings::SP_SCRIPTS ) );
+    
+    if ( QDir( info.absolutePath() ) != home )
+    {
+        return QString::null;
+    }
+    
+    return QString( "%1c" ).arg( info.absoluteFilePath() );
+}
+
+bool MkSShellInterpreter::compileScript( const QString& fileName, MkSShellInterpreter::CompiledScript& script ) const
 {
+    const QFileInfo info( fileName );
+    const QString cacheFileName = compiledFileName( fileName );
+    QFile cache( cacheFileName );
+    
+    script.fileName = info.absoluteFilePath();
+    script.commands.clear();
+    script.arguments.clear();
+    
+    // reuse the compiled script if it is still in sync with its source
+    if ( !cacheFileName.isNull() && info.exists() && cache.open( QIODevice::ReadOnly ) )
+    {
+        QDataStream stream( &cache );
+        stream.setVersion( QDataStream::Qt_4_6 );
+        
+        quint32 magic = 0;
+        qint32 version = 0;
+        QString applicationVersion;
+        qint64 size = -1;
+        QDateTime lastModified;
+        
+        stream >> magic >> version;
+        
+        if ( magic == MkSShell_CompiledMagic && version == MkSShell_CompiledVersion )
+        {
+            stream >> applicationVersion >> size >> lastModified;
+            
+            if ( applicationVersion == PACKAGE_VERSION && size == info.size() && lastModified == info.lastModified() )
+            {
+                stream >> script.commands >> script.arguments;
+                
+                if ( stream.status() == QDataStream::Ok && script.commands.count() == script.arguments.count() )
+                {
+                    return true;
+                }
+            }
+        }
+        
+        cache.close();
+        script.commands.clear();
+        script.arguments.clear();
+    }
+    
     QFile file( fileName );
     
     // open file in text mode
@@ -116,9 +182,9 @@ bool MkSShellInterpreter::loadScript( const QString& fileName )
         return false;
     }
     
-    QString buffer = QString::fromUtf8( file.readAll() );
+    const QString buffer = QString::fromUtf8( file.readAll() );
     
-    // execute each command line
+    // parse each command line
     foreach ( const QString& command, buffer.split( "\n" ) )
     {
         // ignore comments
@@ -127,10 +193,82 @@ bool MkSShellInterpreter::loadScript( const QString& fileName )
             continue;
         }
         
-        interpret( command, 0 );
+        const QStringList arguments = parseCommand( command );
+        
+        // ignore empty lines
+        if ( arguments.isEmpty() )
+        {
+            continue;
+        }
+        
+        // drop the commands that can't be executed so they are reported only once
+        const CommandValidatorPtr validator = mCommandValidators.value( arguments.first() );
+        
+        if ( validator )
+        {
+            const QString error = validator( arguments.first(), arguments.mid( 1 ) );
+            
+            if ( !error.isNull() )
+            {
+                qWarning( "%s", tr( "%1: ignoring invalid command '%2': %3" ).arg( info.fileName() ).arg( command ).arg( error ).toLocal8Bit().constData() );
+                continue;
+            }
+        }
+        
+        script.commands << command;
+        script.arguments << arguments;
     }
     
     file.close();
+    
+    // the compiled script is only an optimization, failing to write it is not an error
+    if ( !cacheFileName.isNull() && cache.open( QIODevice::WriteOnly | QIODevice::Truncate ) )
+    {
+        QDataStream stream( &cache );
+        stream.setVersion( QDataStream::Qt_4_6 );
+        stream << MkSShell_CompiledMagic << MkSShell_CompiledVersion << QString( PACKAGE_VERSION ) << qint64( info.size() ) << info.lastModified();
+        stream << script.commands << script.arguments;
+    }
+    
+    return true;
+}
+
+void MkSShellInterpreter::executeScript( const MkSShellInterpreter::CompiledScript& script )
+{
+    for ( int i = 0; i < script.commands.count(); i++ )
+    {
+        execute( script.commands.at( i ), script.arguments.at( i ), 0 );
+    }
+}
+
+bool MkSShellInterpreter::isDeferrable( const MkSShellInterpreter::CompiledScript& script ) const
+{
+    if ( script.arguments.isEmpty() )
+    {
+        return false;
+    }
+    
+    foreach ( const QStringList& arguments, script.arguments )
+    {
+        if ( !mDeferrableCommands.contains( arguments.first() ) )
+        {
+            return false;
+        }
+    }
+    
+    return true;
+}
+
+bool MkSShellInterpreter::loadScript( const QString& fileName )
+{
+    CompiledScript script;
+    
+    if ( !compileScript( fileName, script ) )
+    {
+        return false;
+    }
+    
+    executeScript( script );
     return true;
 }
 
@@ -141,10 +279,44 @@ void MkSShellInterpreter::loadHomeScripts()
     
     foreach ( const QFileInfo& file, files )
     {
-        if ( !loadScript( file.absoluteFilePath() ) )
+        CompiledScript script;
+        
+        if ( !compileScript( file.absoluteFilePath(), script ) )
         {
             MonkeyCore::messageManager()->appendMessage( tr( "An error occur while loading script: '%1'" ).arg( file.fileName() ) );
         }
+        // scripts only feeding deferrable commands are executed when their subsystem first needs them
+        else if ( isDeferrable( script ) )
+        {
+            mDeferredScripts << script;
+        }
+        else
+        {
+            executeScript( script );
+        }
+    }
+}
+
+void MkSShellInterpreter::executeDeferredScripts( const QString& command )
+{
+    QList<CompiledScript> scripts;
+    
+    // take the scripts first, executing them may call back here
+    for ( int i = 0; i < mDeferredScripts.count(); i++ )
+    {
+        foreach ( const QStringList& arguments, mDeferredScripts.at( i ).arguments )
+        {
+            if ( arguments.first() == command )
+            {
+                scripts << mDeferredScripts.takeAt( i-- );
+                break;
+            }
+        }
+    }
+    
+    foreach ( const CompiledScript& script, scripts )
+    {
+        executeScript( script );
     }
 }
 
@@ -160,8 +332,11 @@ QString MkSShellInterpreter::usage( const QString& command ) const
 
 QString MkSShellInterpreter::interpret( const QString& command, int* result ) const
 {
-    QStringList parts = parseCommand( command );
-    
+    return execute( command, parseCommand( command ), result );
+}
+
+QString MkSShellInterpreter::execute( const QString& command, QStringList parts, int* result ) const
+{
     if ( parts.isEmpty() || !mCommandImplementations.contains( parts.first() ) )
     {
         if ( result )
@@ -199,9 +374,36 @@ void MkSShellInterpreter::removeCommandImplementation( const QString& command )
     mCommandImplementations.remove( command );
     mCommandImplementationsData.remove( command );
     mCommandHelps.remove( command );
+    mCommandValidators.remove( command );
+    mDeferrableCommands.removeOne( command );
 }
 
 void MkSShellInterpreter::setCommandHelp( const QString& command, const QString& help )
 {
     mCommandHelps[ command ] = help;
 }
+
+void MkSShellInterpreter::setCommandValidator( const QString& command, CommandValidatorPtr function )
+{
+    if ( function )
+    {
+        mCommandValidators[ command ] = function;
+    }
+    else
+    {
+        mCommandValidators.remove( command );
+    }
+}
+
+void MkSShellInterpreter::setCommandDeferrable( const QString& command, bool deferrable )
+{
+    if ( deferrable && !mDeferrableCommands.contains( command ) )
+    {
+        mDeferrableCommands << command;
+    }
+    else if ( !deferrable )
+    {
+        mDeferrableCommands.removeOne( command );
+        executeDeferredScripts( command );
+    }
+}
@@ -32,6 +32,13 @@ QString commandImplementation( const QString& command, const QStringList& argume
 */
 typedef QString (*CommandImplementationPtr)(const QString&, const QStringList&, int*, class MkSShellInterpreter*, void* );
 
+/*
+Pointer to function
+QString commandValidator( const QString& command, const QStringList& arguments )
+Returns an error message if the arguments can't be executed by the command, else a null string.
+*/
+typedef QString (*CommandValidatorPtr)(const QString&, const QStringList& );
+
 class Q_MONKEY_EXPORT MkSShellInterpreter : public QObject, public pConsoleCommand
 {
     Q_OBJECT
@@ -55,14 +62,33 @@ public:
     void addCommandImplementation( const QString& command, CommandImplementationPtr function, const QString& help = QString::null, void* data = 0 );
     void removeCommandImplementation( const QString& command );
     void setCommandHelp( const QString& command, const QString& help );
+    void setCommandValidator( const QString& command, CommandValidatorPtr function );
+    void setCommandDeferrable( const QString& command, bool deferrable );
+    void executeDeferredScripts( const QString& command );
     
 protected:
+    // a script parsed once and cached on disk next to its source
+    struct CompiledScript
+    {
+        QString fileName;
+        QStringList commands;
+        QList<QStringList> arguments;
+    };
+    
     static QPointer<MkSShellInterpreter> mInstance;
     QHash<QString, CommandImplementationPtr> mCommandImplementations;
     QHash<QString, void*> mCommandImplementationsData;
     QHash<QString, QString> mCommandHelps;
+    QHash<QString, CommandValidatorPtr> mCommandValidators;
+    QStringList mDeferrableCommands;
+    QList<CompiledScript> mDeferredScripts;
     
     MkSShellInterpreter( QObject* parent = 0 );
+    static QString compiledFileName( const QString& fileName );
+    bool compileScript( const QString& fileName, CompiledScript& script ) const;
+    void executeScript( const CompiledScript& script );
+    bool isDeferrable( const CompiledScript& script ) const;
+    QString execute( const QString& command, QStringList parts, int* result ) const;
     static QString interpretHelp( const QString&, const QStringList& arguments, int* result, MkSShellInterpreter* interpreter, void* data );
     static QString interpretEcho( const QString&, const QStringList& arguments, int* result, MkSShellInterpreter* interpreter, void* data );
     
@@ -46,6 +46,8 @@ pFileManager::pFileManager( QObject* o )
     connect( MonkeyCore::workspace(), SIGNAL( documentClosed( pAbstractChild* ) ), this, SIGNAL( documentClosed( pAbstractChild* ) ) );
     connect( MonkeyCore::workspace(), SIGNAL( documentReloaded( pAbstractChild* ) ), this, SIGNAL( documentReloaded( pAbstractChild* ) ) );
     connect( MonkeyCore::workspace(), SIGNAL( currentDocumentChanged( pAbstractChild* ) ), this, SIGNAL( currentDocumentChanged( pAbstractChild* ) ) );
+    connect( MonkeyCore::workspace(), SIGNAL( documentChanged( pAbstractChild* ) ), this, SLOT( document_changed( pAbstractChild* ) ) );
+    connect( MonkeyCore::workspace(), SIGNAL( documentClosed( pAbstractChild* ) ), this, SLOT( document_closed( pAbstractChild* ) ) );
     
     // projects
     connect( MonkeyCore::projectsManager(), SIGNAL( projectOpened( XUPProjectItem* ) ), this, SIGNAL( opened( XUPProjectItem* ) ) );
@@ -386,14 +388,37 @@ void pFileManager::computeModifiedBuffers()
     
     foreach ( pAbstractChild* document, MonkeyCore::workspace()->documents() )
     {
+        const uint generation = mDocumentsGeneration.value( document );
+        
+        // skip documents not edited since the last notification
+        if ( mNotifiedDocumentsGeneration.value( document ) == generation )
+        {
+            continue;
+        }
+        
+        mNotifiedDocumentsGeneration[ document ] = generation;
+        
         if ( document->isModified() )
         {
-            const QString content = document->fileBuffer();
-            entries[ document->filePath() ] = content;
+            entries[ document->filePath() ] = document->fileBuffer();
         }
     }
     
-    emit buffersChanged( entries );
+    if ( !entries.isEmpty() )
+    {
+        emit buffersChanged( entries );
+    }
+}
+
+void pFileManager::document_changed( pAbstractChild* document )
+{
+    mDocumentsGeneration[ document ]++;
+}
+
+void pFileManager::document_closed( pAbstractChild* document )
+{
+    mDocumentsGeneration.remove( document );
+    mNotifiedDocumentsGeneration.remove( document );
 }
 
 XUPProjectItem* pFileManager::currentProject() const
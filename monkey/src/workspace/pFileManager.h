@@ -24,6 +24,7 @@
 #include <QObject>
 #include <QPoint>
 #include <QMap>
+#include <QHash>
 #include <QStringList>
 
 class pAbstractChild;
@@ -54,7 +55,7 @@ public:
     pAbstractChild* openedDocument( const QString& fileName ) const;
     // return a file buffer, if file is open, the current live buffer is return, else the physically one.
     QString fileBuffer( const QString& fileName, const QString& codec, bool& ok ) const;
-    // compute the modified buffers list
+    // compute the modified buffers list, only the documents changed since the last call are notified
     void computeModifiedBuffers();
 
     XUPProjectItem* currentProject() const;
@@ -69,12 +70,18 @@ public:
 
 protected:
     QMap<QString, QStringList> mAssociations; // language, suffixes
+    QHash<pAbstractChild*, uint> mDocumentsGeneration; // document, content generation
+    QHash<pAbstractChild*, uint> mNotifiedDocumentsGeneration; // document, content generation of the last buffersChanged()
     
     pFileManager( QObject* parent = 0 );
     
     void initializeInterpreterCommands();
     static QString commandInterpreter( const QString& command, const QStringList& arguments, int* result, MkSShellInterpreter* interpreter, void* data );
 
+protected slots:
+    void document_changed( pAbstractChild* document );
+    void document_closed( pAbstractChild* document );
+
 public slots:
     // main menu action handlers
     void fileOpen_triggered();
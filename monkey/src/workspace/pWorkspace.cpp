@@ -43,6 +43,7 @@
 #include "xupmanager/gui/XUPProjectManager.h"
 #include "xupmanager/core/XUPProjectItem.h"
 #include "coremanager/MonkeyCore.h"
+#include "coremanager/StartupProfiler.h"
 #include "maininterface/UIMain.h"
 #include "statusbar/StatusBar.h"
 #include "pluginsmanager/PluginsManager.h"
@@ -101,6 +102,8 @@ pWorkspace::pWorkspace( QMainWindow* parent )
     // creaet file watcher
     mFileWatcher = new QFileSystemWatcher( this );
     mContentChangedTimer = new QTimer( this );
+    mSessionTimer = new QTimer( this );
+    mSessionTimer->setSingleShot( true );
     
     // init view mode actions
     QList<QAction*> actions = mViewModesGroup->actions();
@@ -156,6 +159,7 @@ pWorkspace::pWorkspace( QMainWindow* parent )
     connect( parent, SIGNAL( urlsDropped( const QList<QUrl>& ) ), this, SLOT( internal_urlsDropped( const QList<QUrl>& ) ) );
     connect( MonkeyCore::projectsManager(), SIGNAL( currentProjectChanged( XUPProjectItem*, XUPProjectItem* ) ), this, SLOT( internal_currentProjectChanged( XUPProjectItem*, XUPProjectItem* ) ) );
     connect( mContentChangedTimer, SIGNAL( timeout() ), this, SLOT( contentChangedTimer_timeout() ) );
+    connect( mSessionTimer, SIGNAL( timeout() ), this, SLOT( sessionTimer_timeout() ) );
     connect( MonkeyCore::multiToolBar(), SIGNAL( notifyChanges() ), this, SLOT( multitoolbar_notifyChanges() ) );
 }
 
@@ -509,6 +513,11 @@ bool pWorkspace::closeAllDocuments()
     // close all object, disconnecting them
     if ( button != UISaveFiles::bCancelClose )
     {
+        // abandon a pending session restore
+        mSessionTimer->stop();
+        mSessionFiles.clear();
+        mSessionProjects.clear();
+        
         // stop watching files
         foreach ( QMdiSubWindow* window, mMdiArea->subWindowList() )
         {
@@ -725,6 +734,45 @@ void pWorkspace::contentChangedTimer_timeout()
     MonkeyCore::fileManager()->computeModifiedBuffers();
 }
 
+/*!
+    Restore the next session file or project, one by event loop iteration so the
+    main window stays usable while a large session is restored.
+*/
+void pWorkspace::sessionTimer_timeout()
+{
+    if ( !mSessionFiles.isEmpty() )
+    {
+        const QString file = mSessionFiles.takeFirst();
+        StartupProfiler::Scope scope( QFileInfo( file ).fileName(), "session" );
+        pAbstractChild* document = currentDocument();
+        
+        if ( !MonkeyCore::fileManager()->openFile( file, pMonkeyStudio::defaultCodec() ) ) // remove it from recents files
+        {
+            MonkeyCore::recentsManager()->removeRecentFile( file );
+        }
+        // don't steal the document the user is on
+        else if ( document )
+        {
+            setCurrentDocument( document );
+        }
+    }
+    else if ( !mSessionProjects.isEmpty() )
+    {
+        const QString project = mSessionProjects.takeFirst();
+        StartupProfiler::Scope scope( QFileInfo( project ).fileName(), "session" );
+        
+        if ( !MonkeyCore::projectsManager()->openProject( project, pMonkeyStudio::defaultCodec() ) ) // remove it from recents projects
+        {
+            MonkeyCore::recentsManager()->removeRecentProject( project );
+        }
+    }
+    
+    if ( !mSessionFiles.isEmpty() || !mSessionProjects.isEmpty() )
+    {
+        mSessionTimer->start();
+    }
+}
+
 void pWorkspace::multitoolbar_notifyChanges()
 {
     pMultiToolBar* mtb = MonkeyCore::multiToolBar();
@@ -832,6 +880,7 @@ void pWorkspace::fileNew_triggered()
 void pWorkspace::fileSessionSave_triggered()
 {
     QStringList files, projects;
+    pAbstractChild* current = currentDocument();
     
     // files
     foreach ( QMdiSubWindow* window, mMdiArea->subWindowList() )
@@ -840,7 +889,11 @@ void pWorkspace::fileSessionSave_triggered()
         files << document->filePath();
     }
     
+    // the ones still to restore are part of the session too
+    files << mSessionFiles;
+    
     MonkeyCore::settings()->setValue( "Session/Files", files );
+    MonkeyCore::settings()->setValue( "Session/CurrentFile", current ? current->filePath() : QString::null );
     
     // projects
     foreach ( XUPProjectItem* project, MonkeyCore::projectsManager()->topLevelProjects() )
@@ -848,27 +901,27 @@ void pWorkspace::fileSessionSave_triggered()
         projects << project->fileName();
     }
     
+    projects << mSessionProjects;
+    
     MonkeyCore::settings()->setValue( "Session/Projects", projects );
 }
 
 void pWorkspace::fileSessionRestore_triggered()
 {
-    // restore files
-    foreach ( const QString& file, MonkeyCore::settings()->value( "Session/Files", QStringList() ).toStringList() )
+    // files and projects are restored progressively from the event loop, the current file first
+    mSessionFiles = MonkeyCore::settings()->value( "Session/Files", QStringList() ).toStringList();
+    mSessionProjects = MonkeyCore::settings()->value( "Session/Projects", QStringList() ).toStringList();
+    
+    const QString currentFile = MonkeyCore::settings()->value( "Session/CurrentFile" ).toString();
+    
+    if ( mSessionFiles.removeAll( currentFile ) > 0 )
     {
-        if ( !MonkeyCore::fileManager()->openFile( file, pMonkeyStudio::defaultCodec() ) ) // remove it from recents files
-        {
-            MonkeyCore::recentsManager()->removeRecentFile( file );
-        }
+        mSessionFiles.prepend( currentFile );
     }
     
-    // restore projects
-    foreach ( const QString& project, MonkeyCore::settings()->value( "Session/Projects", QStringList() ).toStringList() )
+    if ( !mSessionFiles.isEmpty() || !mSessionProjects.isEmpty() )
     {
-        if ( !MonkeyCore::projectsManager()->openProject( project, pMonkeyStudio::defaultCodec() ) ) // remove it from recents projects
-        {
-            MonkeyCore::recentsManager()->removeRecentProject( project );
-        }
+        mSessionTimer->start();
     }
 }
 
@@ -90,6 +90,9 @@ protected:
     pOpenedFileExplorer* mOpenedFileExplorer;
     QFileSystemWatcher* mFileWatcher;
     QTimer* mContentChangedTimer;
+    QTimer* mSessionTimer;
+    QStringList mSessionFiles; // session files not yet restored
+    QStringList mSessionProjects; // session projects not yet restored
     static int CONTENT_CHANGED_TIME_OUT;
     static QString DEFAULT_CONTEXT;
     
@@ -104,6 +107,7 @@ protected slots:
     void document_fileReloaded();
 
     void contentChangedTimer_timeout();
+    void sessionTimer_timeout();
     void multitoolbar_notifyChanges();
     void viewModes_triggered( QAction* action );
     void mdiArea_subWindowActivated( QMdiSubWindow* document );
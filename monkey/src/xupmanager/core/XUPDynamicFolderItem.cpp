@@ -414,6 +414,8 @@ void XUPDynamicFolderItem::rowsInserted( const QModelIndex& parent, int start, i
         // nothing special to do as we do direct mapping in child( int row )
         model->endInsertRows();
     }
+    
+    project()->invalidateSourceFiles( true );
 }
 
 void XUPDynamicFolderItem::rowsMoved( const QModelIndex& sourceParent, int sourceStart, int sourceEnd, const QModelIndex& destinationParent, int destinationRow )
@@ -438,6 +440,8 @@ void XUPDynamicFolderItem::rowsRemoved( const QModelIndex& parent, int start, in
     if ( model ) {
         model->endRemoveRows();
     }
+    
+    project()->invalidateSourceFiles( true );
 }
 
 void XUPDynamicFolderItem::rootPathChanged( const QString& newPath )
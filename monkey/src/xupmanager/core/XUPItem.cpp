@@ -19,6 +19,7 @@
 #include "XUPItem.h"
 #include "xupmanager/core/XUPDynamicFolderItem.h"
 #include "xupmanager/core/XUPProjectItem.h"
+#include "xupmanager/core/XUPProjectItemCache.h"
 #include "xupmanager/core/XUPProjectModel.h"
 #include "pIconManager.h"
 
@@ -28,6 +29,8 @@ XUPItem::XUPItem( const QDomElement& node, XUPItem* parent )
 {
     mModel = 0;
     mDomElement = node;
+    mChildItemsBuilt = false;
+    mRow = -1;
     mParentItem = parent;
     
     // FIX old format projects
@@ -119,43 +122,73 @@ void XUPItem::setParent( XUPItem* parentItem )
     mParentItem = parentItem;
 }
 
-XUPItem* XUPItem::child( int i )
+void XUPItem::buildChildItems() const
 {
-    if ( mChildItems.contains( i ) ) {
-        return mChildItems[ i ];
+    if ( mChildItemsBuilt ) {
+        return;
     }
-
-    if ( i >= 0 && i < mDomElement.childNodes().count() ) {
-        QDomElement childElement = mDomElement.childNodes().item( i ).toElement();
+    
+    mChildItemsBuilt = true;
+    
+    switch ( type() ) {
+        case XUPItem::Comment:
+        case XUPItem::EmptyLine:
+        case XUPItem::Path:
+        case XUPItem::File:
+        case XUPItem::Value:
+            return;
+        default:
+            break;
+    }
+    
+    XUPItem* parent = const_cast<XUPItem*>( this );
+    QVector<XUPItem*> items;
+    
+    // walk the dom children once, QDomNodeList index access is linear
+    for ( QDomElement childElement = mDomElement.firstChildElement(); !childElement.isNull(); childElement = childElement.nextSiblingElement() ) {
         XUPItem* childItem = childElement.tagName().toLower() == "dynamicfolder"
-            ? new XUPDynamicFolderItem( childElement, const_cast<XUPItem*>( this ) )
-            : new XUPItem( childElement, const_cast<XUPItem*>( this ) );
-        mChildItems[ i ] = childItem;
-        return childItem;
+            ? new XUPDynamicFolderItem( childElement, parent )
+            : new XUPItem( childElement, parent );
+        items << childItem;
     }
     
-    return 0;
+    // children added before the build are not dom children
+    mChildItems = items +mChildItems;
+    updateChildRows( 0 );
 }
 
-XUPItemList XUPItem::childrenList() const
+void XUPItem::updateChildRows( int from ) const
 {
-    // create all child if needed before returning list
-    for ( int i = 0; i < childCount(); i++ ) {
-        const_cast<XUPItem*>( this )->child( i );
+    for ( int i = from; i < mChildItems.count(); i++ ) {
+        mChildItems[ i ]->mRow = i;
     }
-    
-    // return children
-    return mChildItems.values();
+}
+
+XUPItem* XUPItem::child( int i )
+{
+    buildChildItems();
+    return mChildItems.value( i );
+}
+
+XUPItemList XUPItem::childrenList() const
+{
+    buildChildItems();
+    return mChildItems.toList();
 }
 
 int XUPItem::childIndex( XUPItem* child ) const
 {
-    return mChildItems.key( child, -1 );
+    buildChildItems();
+    
+    const int row = child ? child->mRow : -1;
+    return row >= 0 && row < mChildItems.count() && mChildItems.at( row ) == child ? row : -1;
 }
 
 void XUPItem::addChild( XUPItem* item )
 {
-    int row = childCount();
+    buildChildItems();
+    
+    int row = mChildItems.count();
     XUPProjectModel* m = model();
     
     // inform begin insert
@@ -163,7 +196,8 @@ void XUPItem::addChild( XUPItem* item )
         m->beginInsertRows( index(), row, row );
     }
     
-    mChildItems[ row ] = item;
+    mChildItems << item;
+    item->mRow = row;
     item->setParent( this );
     
     // inform end insert
@@ -184,13 +218,6 @@ int XUPItem::row() const
 
 int XUPItem::childCount() const
 {
-    int count = mDomElement.childNodes().count();
-    
-    // include/sub project are not node children, so have to take them in account
-    if ( !mChildItems.isEmpty() ) {
-        count = qMax( count, mChildItems.keys().last() +1 );
-    }
-    
     switch ( type() ) {
         case XUPItem::Comment:
         case XUPItem::EmptyLine:
@@ -199,7 +226,8 @@ int XUPItem::childCount() const
         case XUPItem::Value:
             return 0;
         default:
-            return count;
+            buildChildItems();
+            return mChildItems.count();
     }
 }
 
@@ -216,45 +244,45 @@ void XUPItem::removeChild( XUPItem* item )
         // inform model of remove
         XUPProjectModel* m = model();
         
+        // begin remove
         if ( m ) {
-            // begin remove
             m->beginRemoveRows( index(), id, id );
-            
-            // remove
-            bool isDirectChild = item->mDomElement.parentNode() == mDomElement;
-            
-            if ( isDirectChild ) {
-                foreach ( const int& key, mChildItems.keys() ) {
-                    if ( key == id ) {
-                        QDomNode node = item->mDomElement;
-                        mDomElement.removeChild( node );
-                        mChildItems.remove( key );
-                        delete item;
-                    }
-                    else if ( key > id ) {
-                        mChildItems[ key -1 ] = mChildItems[ key ];
-                        mChildItems.remove( key );
-                    }
-                }
-            }
-            else {
-                delete mChildItems.take( id );
-            }
-            
-            // end remove
-            m->endRemoveRows();
         }
-        else {
-            delete mChildItems.take( id );
+        
+        // remove, include/sub project are not node children
+        if ( item->mDomElement.parentNode() == mDomElement ) {
+            QDomNode node = item->mDomElement;
+            mDomElement.removeChild( node );
+        }
+        
+        XUPProjectItem::cache()->remove( item );
+        invalidateProjectSourceFiles( item );
+        removeSpans();
+        mChildItems.remove( id );
+        updateChildRows( id );
+        delete item;
+        
+        // end remove
+        if ( m ) {
+            m->endRemoveRows();
         }
     }
 }
 
 QDomElement XUPItem::addChildElement( XUPItem::Type type, int& row, bool emitSignals )
 {
+    buildChildItems();
+    
+    // the dom children come first, include/sub project are not node children
+    int count = mChildItems.count();
+    
+    while ( count > 0 && mChildItems.at( count -1 )->mDomElement.parentNode() != mDomElement ) {
+        count--;
+    }
+    
     // calculate row if needed
     if ( row == -1 ) {
-        row = mDomElement.childNodes().count();
+        row = count;
     }
     
     QString stringType;
@@ -300,42 +328,31 @@ QDomElement XUPItem::addChildElement( XUPItem::Type type, int& row, bool emitSig
     // inform model of add
     XUPProjectModel* m = model();
     
-    const int count = mDomElement.childNodes().count();
-    
-    if ( !stringType.isEmpty() && row <= count ) {
+    if ( !stringType.isEmpty() && row >= 0 && row <= count ) {
         // begin insert
         if ( m && emitSignals ) {
             m->beginInsertRows( index(), row, row );
         }
         
-        // re inde existing items
-        QList<int> rows = mChildItems.keys();
-        qSort( rows.begin(), rows.end(), qGreater<int>() );
-        
-        foreach ( const int& key, rows ) {
-            if ( key >= row ) {
-                mChildItems[ key +1 ] = mChildItems.take( key );
-            }
-        }
-        
         // add new one
-        //mChildItems.remove( row );
         QDomElement element = mDomElement.ownerDocument().createElement( stringType );
         
-        if ( count == 0 ) {
-            mDomElement.appendChild( element );
+        if ( row < count ) {
+            mDomElement.insertBefore( element, mChildItems.at( row )->mDomElement );
         }
         else {
-            if ( row == 0 ) {
-                const QDomElement childElement = mDomElement.childNodes().at( 1 ).toElement();
-                mDomElement.insertBefore( element, childElement );
-            }
-            else {
-                const QDomElement childElement = mDomElement.childNodes().at( row -1 ).toElement();
-                mDomElement.insertAfter( element, childElement );
-            }
+            mDomElement.appendChild( element );
         }
         
+        XUPItem* childItem = type == XUPItem::DynamicFolder
+            ? new XUPDynamicFolderItem( element, this )
+            : new XUPItem( element, this );
+        
+        mChildItems.insert( row, childItem );
+        updateChildRows( row );
+        removeSpans();
+        XUPProjectItem::cache()->invalidate( childItem );
+        
         // end insert
         if ( m && emitSignals ) {
             m->endInsertRows();
@@ -458,6 +475,9 @@ void XUPItem::setContent( const QString& content )
         textNode.setData( content );
     }
     
+    XUPProjectItem::cache()->invalidate( this );
+    invalidateProjectSourceFiles( this );
+    removeSpans();
     emitDataChanged();
 }
 
@@ -480,6 +500,9 @@ void XUPItem::setAttribute( const QString& name, const QString& value )
     }
     
     mCacheValues.remove( name );
+    XUPProjectItem::cache()->invalidate( this, name );
+    invalidateProjectSourceFiles( this );
+    removeSpans();
     emitDataChanged();
 }
 
@@ -490,6 +513,10 @@ QString XUPItem::cacheValue( const QString& key, const QString& defaultValue ) c
 
 void XUPItem::setCacheValue( const QString& key, const QString& value )
 {
+    if ( key == "content" && type() == XUPItem::File && cacheValue( key ) != value ) {
+        invalidateProjectSourceFiles( this );
+    }
+    
     mCacheValues[ key ] = value;
 }
 
@@ -506,6 +533,44 @@ QString XUPItem::xmlContent() const
     return content;
 }
 
+void XUPItem::invalidateProjectSourceFiles( XUPItem* item )
+{
+    switch ( item->type() ) {
+        case XUPItem::Comment:
+        case XUPItem::EmptyLine:
+        case XUPItem::Value:
+        case XUPItem::Path:
+        case XUPItem::Function:
+        case XUPItem::DynamicFolder:
+            return;
+        default:
+            break;
+    }
+    
+    // include projects files are part of their parent project files
+    const XUPItem* owner = item->type() == XUPItem::Project ? item->parent() : item;
+    XUPProjectItem* project = owner ? owner->project() : 0;
+    
+    // the files of an include project are listed by every project up its include chain
+    while ( project ) {
+        project->invalidateSourceFiles();
+        
+        if ( project == project->rootIncludeProject() ) {
+            break;
+        }
+        
+        project = project->parent()->project();
+    }
+}
+
+void XUPItem::removeSpans()
+{
+    // the source text of the element and of its parents no longer matches their span
+    for ( QDomElement element = mDomElement; !element.isNull() && element.hasAttribute( "span" ); element = element.parentNode().toElement() ) {
+        element.removeAttribute( "span" );
+    }
+}
+
 void XUPItem::emitDataChanged()
 {
     // update model if needed
@@ -23,6 +23,7 @@
 
 #include <QDomElement>
 #include <QMap>
+#include <QVector>
 #include <QIcon>
 #include <QVariant>
 #include <QModelIndex>
@@ -119,7 +120,9 @@ public:
 protected:
     XUPProjectModel* mModel;
     QDomElement mDomElement;
-    mutable QMap<int, XUPItem*> mChildItems;
+    mutable QVector<XUPItem*> mChildItems; // the dom children first, then the other ones (ie: sub projects)
+    mutable bool mChildItemsBuilt;
+    int mRow;
     XUPItem* mParentItem;
     QMap<QString, QString> mCacheValues;
     
@@ -129,6 +132,14 @@ protected:
     virtual QDomElement addChildElement( XUPItem::Type type, int& row, bool emitSignals = true );
     // set the parent item. Call automaticaly from parent's addChild
     void setParent( XUPItem* parentItem );
+    // create the items of the dom children, done once on first access
+    void buildChildItems() const;
+    // update the stored row of the children starting at row from
+    void updateChildRows( int from ) const;
+    // inform the project owning item that its source files may have changed
+    static void invalidateProjectSourceFiles( XUPItem* item );
+    // drop the source position of the element and its parents, see the span attribute
+    void removeSpans();
 
     // return the node element associate with this item
     QDomElement node() const;
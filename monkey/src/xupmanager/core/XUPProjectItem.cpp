@@ -51,6 +51,9 @@ XUPProjectItemCacheBackend XUPProjectItem::mProjectsCacheBackend = XUPProjectIte
 XUPProjectItem::XUPProjectItem()
     : XUPItem( QDomElement(), 0 )
 {
+    mSourceFilesValid = false;
+    mDynamicFilesValid = false;
+    mSourceFilesRevision = 0;
 }
 
 XUPProjectItem::~XUPProjectItem()
@@ -107,7 +110,29 @@ QString XUPProjectItem::relativeFilePath( const QString& _fn ) const
 
 QStringList XUPProjectItem::sourceFiles() const
 {
-    QSet<QString> entries;
+    if ( mSourceFilesValid && mDynamicFilesValid ) {
+        return mSourceFiles;
+    }
+    
+    // get dynamic files
+    if ( !mDynamicFilesValid ) {
+        const XUPDynamicFolderSettings settings = XUPProjectItemHelper::projectDynamicFolderSettings( const_cast<XUPProjectItem*>( this ) );
+        
+        mDynamicFiles.clear();
+        
+        if ( settings.Active && !settings.AbsolutePath.isEmpty() && QFile::exists( settings.AbsolutePath ) ) {
+            QDir dir( settings.AbsolutePath );
+            QFileInfoList files = pMonkeyStudio::getFiles( dir, settings.FilesPatterns, true );
+            
+            foreach ( const QFileInfo& fi, files ) {
+                mDynamicFiles << fi.absoluteFilePath();
+            }
+        }
+        
+        mDynamicFilesValid = true;
+    }
+    
+    QSet<QString> entries = mDynamicFiles.toSet();
     
     foreach ( const QString& name, documentFilters().fileVariables() ) {
         XUPItemList variables = getVariables( this, name );
@@ -121,31 +146,117 @@ QStringList XUPProjectItem::sourceFiles() const
         }
     }
     
-    // get dynamic files
-    const XUPDynamicFolderSettings settings = XUPProjectItemHelper::projectDynamicFolderSettings( const_cast<XUPProjectItem*>( this ) );
+    mSourceFiles = entries.toList();
+    mSourceFilesValid = true;
     
-    if ( settings.Active && !settings.AbsolutePath.isEmpty() && QFile::exists( settings.AbsolutePath ) ) {
-        QDir dir( settings.AbsolutePath );
-        QFileInfoList files = pMonkeyStudio::getFiles( dir, settings.FilesPatterns, true );
-        
-        foreach ( const QFileInfo& fi, files ) {
-            entries << fi.absoluteFilePath();
+    return mSourceFiles;
+}
+
+QStringList XUPProjectItem::topLevelProjectSourceFiles() const
+{
+    const XUPProjectItem* topLevelProject = this->topLevelProject();
+    const XUPProjectItem::SourceFilesIndex& index = topLevelProject->sourceFilesIndex();
+    
+    if ( topLevelProject == this ) {
+        return index.owners.keys();
+    }
+    
+    QStringList files;
+    
+    foreach ( XUPProjectItem* project, index.files.keys() ) {
+        if ( isProjectOrChild( project ) ) {
+            files << index.files[ project ];
         }
     }
     
-    return entries.toList();
+    // remove duplicates
+    return files.toSet().toList();
 }
 
-QStringList XUPProjectItem::topLevelProjectSourceFiles() const
+void XUPProjectItem::invalidateSourceFiles( bool dynamicFiles )
 {
-    QStringList files;
+    mSourceFilesValid = false;
+    mSourceFilesRevision++;
+    
+    if ( dynamicFiles ) {
+        mDynamicFilesValid = false;
+    }
+    
+    // track the project so the top level index picks the change on next lookup
+    topLevelProject()->mSourceFilesIndex.projects[ this ] = this;
+}
 
-    foreach ( XUPProjectItem* project, childrenProjects( true ) ) {
-        files << project->sourceFiles();
+const XUPProjectItem::SourceFilesIndex& XUPProjectItem::sourceFilesIndex() const
+{
+    XUPProjectItem::SourceFilesIndex& index = mSourceFilesIndex;
+    
+    if ( !index.initialized ) {
+        foreach ( XUPProjectItem* project, childrenProjects( true ) ) {
+            index.projects[ project ] = project;
+        }
+        
+        index.projects[ const_cast<XUPProjectItem*>( this ) ] = const_cast<XUPProjectItem*>( this );
+        index.initialized = true;
     }
+    
+    foreach ( XUPProjectItem* key, index.projects.keys() ) {
+        XUPProjectItem* project = index.projects.value( key );
+        const bool removed = !project || project->topLevelProject() != this;
+        
+        if ( !removed && index.revisions.value( key, -1 ) == project->mSourceFilesRevision ) {
+            continue;
+        }
+        
+        // drop the previously indexed files of the project, key may point to a deleted project
+        foreach ( const QString& file, index.files.take( key ) ) {
+            XUPProjectItemList& owners = index.owners[ file ];
+            owners.removeAll( key );
+            
+            if ( owners.isEmpty() ) {
+                const QString fileName = QFileInfo( file ).fileName();
+                
+                index.owners.remove( file );
+                index.fileNames[ fileName ].removeAll( file );
+                
+                if ( index.fileNames[ fileName ].isEmpty() ) {
+                    index.fileNames.remove( fileName );
+                }
+            }
+        }
+        
+        if ( removed ) {
+            index.revisions.remove( key );
+            index.projects.remove( key );
+            continue;
+        }
+        
+        // index the current files of the project
+        const QStringList files = project->sourceFiles();
+        
+        foreach ( const QString& file, files ) {
+            XUPProjectItemList& owners = index.owners[ file ];
+            
+            if ( owners.isEmpty() ) {
+                index.fileNames[ QFileInfo( file ).fileName() ] << file;
+            }
+            
+            owners << project;
+        }
+        
+        index.files[ key ] = files;
+        index.revisions[ key ] = project->mSourceFilesRevision;
+    }
+    
+    return index;
+}
 
-    // remove duplicates
-    return files.toSet().toList();
+bool XUPProjectItem::isProjectOrChild( const XUPProjectItem* project ) const
+{
+    while ( project && project != this ) {
+        project = project->mParentItem ? project->mParentItem->project() : 0;
+    }
+    
+    return project == this;
 }
 
 XUPPlugin* XUPProjectItem::driver() const
@@ -285,16 +396,24 @@ QString XUPProjectItem::defaultOperator() const
 QFileInfoList XUPProjectItem::findFile( const QString& partialFilePath ) const
 {
     const QString searchFileName = QFileInfo( partialFilePath ).fileName();
+    const XUPProjectItem::SourceFilesIndex& index = topLevelProject()->sourceFilesIndex();
     QFileInfoList files;
     
-    foreach( XUPProjectItem* project, childrenProjects( true ) ) {
-        foreach( const QString& file, project->sourceFiles() ) {
-            const QFileInfo fileInfo( project->filePath( file ) );
-            
-            if ( fileInfo.exists() && fileInfo.fileName() == searchFileName ) {
-                files << fileInfo;
+    foreach ( const QString& file, index.fileNames.value( searchFileName ) ) {
+        bool owned = false;
+        
+        foreach ( XUPProjectItem* project, index.owners.value( file ) ) {
+            if ( isProjectOrChild( project ) ) {
+                owned = true;
+                break;
             }
         }
+        
+        const QFileInfo fileInfo( file );
+        
+        if ( owned && fileInfo.exists() ) {
+            files << fileInfo;
+        }
     }
     
     return files;
@@ -507,7 +626,7 @@ bool XUPProjectItem::save()
         showError( tr( "Can't write content in project '%1'" ).arg( fileName() ) );
     }
     
-    XUPProjectItem::cache()->build( rootIncludeProject() );
+    XUPProjectItem::cache()->refresh( rootIncludeProject() );
 
     return result;
 }
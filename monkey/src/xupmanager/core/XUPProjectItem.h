@@ -21,6 +21,7 @@
 
 #include <QObject>
 #include <QFileInfo>
+#include <QPointer>
 
 #include "MonkeyExport.h"
 
@@ -79,6 +80,8 @@ public:
     QStringList sourceFiles() const;
     // return the list of all source files for all projects from the root project
     QStringList topLevelProjectSourceFiles() const;
+    // inform the project its source files changed, dynamicFiles to rescan the dynamic folder too
+    void invalidateSourceFiles( bool dynamicFiles = false );
     
     // return the xup plugin associated with this project
     XUPPlugin* driver() const;
@@ -168,17 +171,41 @@ public:
     QString unquotedValue( const QString& value ) const;
     
 protected:
+    // the source files of the top level project and its children, updated per project on lookup
+    struct SourceFilesIndex
+    {
+        SourceFilesIndex() { initialized = false; }
+        
+        bool initialized;
+        QHash<XUPProjectItem*, QPointer<XUPProjectItem> > projects; // project, tracked project
+        QHash<XUPProjectItem*, int> revisions; // project, indexed source files revision
+        QHash<XUPProjectItem*, QStringList> files; // project, indexed source files
+        QHash<QString, QStringList> fileNames; // file name, file paths
+        QHash<QString, XUPProjectItemList> owners; // file path, projects having it
+    };
+    
     QDomDocument mDocument;
     QString mCodec;
     QString mFileName;
     // Action pointers stored here for delete it, when current project changed
     QHash<QString, QAction*> mInstalledActions;
     QHash<QString, pCommand> mCommands; // project installed commands by name pCommand::name()
+    mutable QStringList mSourceFiles;
+    mutable QStringList mDynamicFiles;
+    mutable bool mSourceFilesValid;
+    mutable bool mDynamicFilesValid;
+    int mSourceFilesRevision;
+    mutable XUPProjectItem::SourceFilesIndex mSourceFilesIndex; // only filled for top level projects
     static XUPProjectItemCache mProjectsCache;
     static XUPProjectItemCacheBackend mProjectsCacheBackend;
     
     virtual UIXUPEditor* newEditDialog() const;
     
+    // return the up to date source files index, must be called on a top level project
+    const XUPProjectItem::SourceFilesIndex& sourceFilesIndex() const;
+    // return true if project is this project or one of its children
+    bool isProjectOrChild( const XUPProjectItem* project ) const;
+    
 protected slots:
     // Common handler for actions, which execute pCommand. Does few checks, then executes pCommand
     // Can be overrided if needed.
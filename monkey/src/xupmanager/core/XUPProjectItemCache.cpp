@@ -20,6 +20,7 @@
 #include "xupmanager/core/XUPProjectItem.h"
 #include "xupmanager/core/XUPProjectItemHelper.h"
 
+#include <QMap>
 #include <QDebug>
 
 uint qHash( const XUPProjectItemCache::ProjectPointer& pointer )
@@ -113,6 +114,7 @@ void XUPProjectItemCacheBackend::recursiveScan( XUPProjectItem* project, XUPItem
 {
     XUPItem* root = _root ? _root : project;
     QStringList values;
+    QSet<QString> references;
     
     //qWarning() << project->fileName() << root->project()->rootIncludeProject()->fileName() << root->displayText();
     Q_ASSERT( project == root->project()->rootIncludeProject() );
@@ -125,6 +127,7 @@ void XUPProjectItemCacheBackend::recursiveScan( XUPProjectItem* project, XUPItem
                 const QString content = guessedContent( project, child->project(), QStringList( child->content() ) ).join( " " );
                 child->setCacheValue( "content", content );
                 values << content;
+                references += variableReferences( child->content() );
                 break;
             }
             case XUPItem::DynamicFolder:
@@ -138,6 +141,10 @@ void XUPProjectItemCacheBackend::recursiveScan( XUPProjectItem* project, XUPItem
             case XUPItem::Function: {
                 const QString parameters = guessedContent( project, child->project(), QStringList( child->attribute( "parameters" ) ) ).join( " " );
                 child->setCacheValue( "parameters", parameters );
+                
+                if ( mCache ) {
+                    mCache->mDependencies[ project ].structural += variableReferences( child->attribute( "parameters" ) );
+                }
                 break;
             }
             default:
@@ -149,6 +156,10 @@ void XUPProjectItemCacheBackend::recursiveScan( XUPProjectItem* project, XUPItem
     
     if ( root->type() == XUPItem::Variable ) {
         updateVariable( project, root->attribute( "name" ), values, root->attribute( "operator" ) );
+        
+        if ( mCache ) {
+            mCache->addAssignment( project, root, references );
+        }
     }
     
     if ( root->type() != XUPItem::DynamicFolder ) {
@@ -163,8 +174,32 @@ bool XUPProjectItemCacheBackend::cacheRecursiveScanHook( XUPProjectItem* project
     return false;
 }
 
+QSet<QString> XUPProjectItemCacheBackend::variableReferences( const QString& content )
+{
+    QSet<QString> references;
+    
+    if ( !content.contains( "$$" ) ) {
+        return references;
+    }
+    
+    const QRegExp rx( "\\$\\$\\{?([\\w._]+)" );
+    int pos = 0;
+    
+    while ( ( pos = rx.indexIn( content, pos ) ) != -1 ) {
+        references << rx.cap( 1 );
+        pos += rx.matchedLength();
+    }
+    
+    return references;
+}
+
 // XUPProjectItemCache
 
+XUPProjectItemCache::XUPProjectItemCache()
+{
+    mScanning = 0;
+}
+
 XUPProjectItemCache::ProjectCache& XUPProjectItemCache::cachedData() const
 {
     return mCache;
@@ -181,13 +216,273 @@ void XUPProjectItemCache::update( XUPProjectItem* project, XUPItem* root )
 {
 //qWarning() << "*** UPDATE" << project->fileName() << ( root ? root->displayText() : "" );
     if ( project->cacheBackend() ) {
+        mScanning++;
         project->cacheBackend()->recursiveScan( project, root );
+        mScanning--;
     }
 }
 
 void XUPProjectItemCache::clear( XUPProjectItem* project )
 {
     mCache.remove( project );
+    mDependencies.remove( project );
+}
+
+void XUPProjectItemCache::refresh( XUPProjectItem* project )
+{
+    ProjectsDependencies::iterator it = mDependencies.find( project );
+    
+    if ( it == mDependencies.end() ) {
+        return;
+    }
+    
+    if ( it.value().rebuild ) {
+        build( project );
+        return;
+    }
+    
+    if ( it.value().invalidated.isEmpty() ) {
+        return;
+    }
+    
+    // collect the invalidated variables and their dependents
+    QStringList pending = it.value().invalidated.toList();
+    QSet<QString> variables;
+    
+    it.value().invalidated.clear();
+    
+    while ( !pending.isEmpty() ) {
+        const QString variable = pending.takeFirst();
+        
+        if ( variables.contains( variable ) ) {
+            continue;
+        }
+        
+        // functions parameters can change the project structure (include, subdirs...)
+        if ( it.value().structural.contains( variable ) ) {
+            build( project );
+            return;
+        }
+        
+        variables << variable;
+        pending << it.value().dependents.value( variable ).toList();
+    }
+    
+    // the referenced variables are replayed too, so each assignment reads the content they have at its position
+    QSet<QString> replayed;
+    
+    pending = variables.toList();
+    
+    while ( !pending.isEmpty() ) {
+        const QString variable = pending.takeFirst();
+        
+        if ( replayed.contains( variable ) ) {
+            continue;
+        }
+        
+        replayed << variable;
+        pending << it.value().references.value( variable ).toList();
+    }
+    
+    // the assignments are replayed in document order like the full scan
+    QMap<int, XUPItem*> assignments;
+    
+    foreach ( const QString& variable, replayed ) {
+        if ( !it.value().assignments.contains( variable ) ) {
+            continue;
+        }
+        
+        mCache[ project ][ variable ] = QStringList();
+        
+        foreach ( XUPItem* assignment, it.value().assignments.value( variable ) ) {
+            assignments[ it.value().positions.value( assignment ) ] = assignment;
+        }
+    }
+    
+    QHash<QString, QSet<QString> > references;
+    
+    mScanning++;
+    
+    foreach ( XUPItem* assignment, assignments ) {
+        const QString variable = assignment->attribute( "name" );
+        evaluate( project, assignment, references[ variable ], variables.contains( variable ) );
+    }
+    
+    mScanning--;
+    
+    foreach ( const QString& variable, variables ) {
+        setReferences( project, variable, references.value( variable ) );
+    }
+}
+
+void XUPProjectItemCache::invalidate( XUPItem* item, const QString& attribute )
+{
+    XUPProjectItem* project = item && !mScanning ? item->project() : 0;
+    project = project ? project->rootIncludeProject() : 0;
+    
+    if ( !project || !mDependencies.contains( project ) ) {
+        return;
+    }
+    
+    ProjectDependencies& dependencies = mDependencies[ project ];
+    
+    switch ( item->type() ) {
+        case XUPItem::Value:
+        case XUPItem::File:
+        case XUPItem::Path: {
+            const XUPItem* variable = item->parent();
+            
+            if ( variable && variable->type() == XUPItem::Variable ) {
+                dependencies.invalidated << variable->attribute( "name" );
+            }
+            
+            break;
+        }
+        case XUPItem::Variable: {
+            // a new or renamed variable changes the assignments order
+            const QString name = item->attribute( "name" );
+            
+            if ( !attribute.isNull() && attribute != "name" && attribute != "operator" ) {
+                break;
+            }
+            else if ( dependencies.assignments.value( name ).contains( item ) ) {
+                dependencies.invalidated << name;
+            }
+            else {
+                invalidateStructure( project );
+            }
+            
+            break;
+        }
+        case XUPItem::Project:
+        case XUPItem::Comment:
+        case XUPItem::EmptyLine:
+        case XUPItem::DynamicFolder:
+            break;
+        default:
+            // comments, nesting or spans of scopes and functions don't change the evaluation
+            if ( attribute.isNull() || attribute == "name" || attribute == "parameters" || attribute == "content" ) {
+                invalidateStructure( project );
+            }
+            
+            break;
+    }
+}
+
+void XUPProjectItemCache::remove( XUPItem* item )
+{
+    XUPProjectItem* project = item ? item->project() : 0;
+    project = project ? project->rootIncludeProject() : 0;
+    
+    if ( !project || !mDependencies.contains( project ) ) {
+        return;
+    }
+    
+    ProjectDependencies& dependencies = mDependencies[ project ];
+    
+    // deleted items must not be kept by the assignments, even while scanning
+    switch ( item->type() ) {
+        case XUPItem::Value:
+        case XUPItem::File:
+        case XUPItem::Path:
+            invalidate( item );
+            break;
+        case XUPItem::Variable: {
+            const QString name = item->attribute( "name" );
+            
+            dependencies.assignments[ name ].removeAll( item );
+            dependencies.positions.remove( item );
+            
+            if ( !mScanning ) {
+                dependencies.invalidated << name;
+            }
+            
+            break;
+        }
+        case XUPItem::Comment:
+        case XUPItem::EmptyLine:
+        case XUPItem::DynamicFolder:
+            break;
+        default:
+            invalidateStructure( project );
+            break;
+    }
+}
+
+void XUPProjectItemCache::addAssignment( XUPProjectItem* project, XUPItem* variable, const QSet<QString>& references )
+{
+    ProjectDependencies& dependencies = mDependencies[ project ];
+    const QString name = variable->attribute( "name" );
+    
+    dependencies.assignments[ name ] << variable;
+    dependencies.positions[ variable ] = dependencies.positions.count();
+    dependencies.references[ name ] += references;
+    
+    foreach ( const QString& reference, references ) {
+        dependencies.dependents[ reference ] << name;
+    }
+}
+
+void XUPProjectItemCache::setReferences( XUPProjectItem* project, const QString& variable, const QSet<QString>& references )
+{
+    ProjectDependencies& dependencies = mDependencies[ project ];
+    
+    foreach ( const QString& reference, dependencies.references.value( variable ) ) {
+        dependencies.dependents[ reference ].remove( variable );
+    }
+    
+    dependencies.references[ variable ] = references;
+    
+    foreach ( const QString& reference, references ) {
+        dependencies.dependents[ reference ] << variable;
+    }
+}
+
+void XUPProjectItemCache::invalidateStructure( XUPProjectItem* project )
+{
+    ProjectDependencies& dependencies = mDependencies[ project ];
+    
+    // the recorded items may be deleted, only a full scan can restore them
+    dependencies.assignments.clear();
+    dependencies.positions.clear();
+    dependencies.rebuild = true;
+}
+
+/*
+    Evaluate one assignment with the current content of the variables it references.
+    refresh() replays the assignments in document order, so this is the content the full scan reads at this position.
+    The scan hook is only called for the re-evaluated variables, not for the ones replayed for their content.
+*/
+void XUPProjectItemCache::evaluate( XUPProjectItem* project, XUPItem* assignment, QSet<QString>& references, bool hook )
+{
+    XUPProjectItemCacheBackend* backend = project->cacheBackend();
+    QStringList values;
+    
+    if ( !backend ) {
+        return;
+    }
+    
+    foreach ( XUPItem* child, assignment->childrenList() ) {
+        switch ( child->type() ) {
+            case XUPItem::Value:
+            case XUPItem::File:
+            case XUPItem::Path: {
+                const QString content = backend->guessedContent( project, child->project(), QStringList( child->content() ) ).join( " " );
+                child->setCacheValue( "content", content );
+                values << content;
+                references += XUPProjectItemCacheBackend::variableReferences( child->content() );
+                break;
+            }
+            default:
+                break;
+        }
+    }
+    
+    backend->updateVariable( project, assignment->attribute( "name" ), values, assignment->attribute( "operator" ) );
+    
+    if ( hook ) {
+        backend->cacheRecursiveScanHook( project, assignment );
+    }
 }
 
 #ifndef QT_NO_DEBUG
@@ -227,6 +522,8 @@ QStringList XUPProjectItemCache::values( XUPProjectItem* project, const QString&
         return QStringList();
     }
     
+    const_cast<XUPProjectItemCache*>( this )->refresh( project );
+    
     if ( !mCache.value( project ).contains( variable ) ) {
         const_cast<XUPProjectItemCache*>( this )->build( project );
     }
@@ -22,6 +22,7 @@
 #include <MonkeyExport.h>
 
 #include <QHash>
+#include <QSet>
 #include <QPointer>
 
 class XUPProjectItem;
@@ -45,6 +46,9 @@ public:
     // a hook of the cache system to inform an item has been cached, this can be usefull for load include/sub projects...
     // return true if project was changed, else false!!
     virtual bool cacheRecursiveScanHook( XUPProjectItem* project, XUPItem* item );
+    
+    // return the project variables names referenced in content, ie: $$NAME or $${NAME}
+    static QSet<QString> variableReferences( const QString& content );
 
 protected:
     XUPProjectItemCache* mCache;
@@ -53,12 +57,15 @@ protected:
 class Q_MONKEY_EXPORT XUPProjectItemCache
 {
     friend class XUPProjectItem;
+    friend class XUPProjectItemCacheBackend;
     
 public:
     typedef QPointer<XUPProjectItem> ProjectPointer; // tracked project
     typedef QHash<QString, QStringList> HashedVariables; // variable name, variable content
     typedef QHash<ProjectPointer, HashedVariables> ProjectCache; // project, variables content
     
+    XUPProjectItemCache();
+    
     // return the hashed projects variable content cache
     XUPProjectItemCache::ProjectCache& cachedData() const;
     
@@ -68,6 +75,13 @@ public:
     void update( XUPProjectItem* project, XUPItem* root = 0 );
     // clear the cache for project
     void clear( XUPProjectItem* project );
+    // re-evaluate the invalidated variables of project and the variables depending on them
+    void refresh( XUPProjectItem* project );
+    
+    // inform the cache that item was added or changed, attribute is the changed attribute name if any
+    void invalidate( XUPItem* item, const QString& attribute = QString::null );
+    // inform the cache that item is about to be deleted
+    void remove( XUPItem* item );
     
     // return the cached variable content as list, building the cache if needed
     QStringList values( XUPProjectItem* project, const QString& variable ) const;
@@ -77,7 +91,29 @@ public:
 #endif
 
 protected:
+    struct ProjectDependencies
+    {
+        ProjectDependencies() { rebuild = false; }
+        
+        QHash<QString, QList<XUPItem*> > assignments; // variable name, variable items in scan order
+        QHash<XUPItem*, int> positions; // variable item, position in the document order
+        QHash<QString, QSet<QString> > references; // variable name, variables referenced by its values
+        QHash<QString, QSet<QString> > dependents; // variable name, variables referencing it
+        QSet<QString> structural; // variables referenced by functions parameters
+        QSet<QString> invalidated; // variables to re-evaluate
+        bool rebuild; // the project structure changed, a full scan is needed
+    };
+    
+    typedef QHash<ProjectPointer, ProjectDependencies> ProjectsDependencies;
+    
     mutable XUPProjectItemCache::ProjectCache mCache;
+    XUPProjectItemCache::ProjectsDependencies mDependencies;
+    int mScanning;
+    
+    void addAssignment( XUPProjectItem* project, XUPItem* variable, const QSet<QString>& references );
+    void setReferences( XUPProjectItem* project, const QString& variable, const QSet<QString>& references );
+    void invalidateStructure( XUPProjectItem* project );
+    void evaluate( XUPProjectItem* project, XUPItem* assignment, QSet<QString>& references, bool hook );
 };
 
 // a way to hash a project
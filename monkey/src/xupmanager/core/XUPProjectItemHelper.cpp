@@ -267,6 +267,8 @@ void XUPProjectItemHelper::setProjectDynamicFolderSettings( XUPProjectItem* proj
         addDynamicFolderSettingsProperty( dynamicFolderSettingsItem, folder.AbsolutePath );
         addDynamicFolderSettingsProperty( dynamicFolderSettingsItem, folder.FilesPatterns.join( ";" ) );
     }
+    
+    project->invalidateSourceFiles( true );
 }
 
 XUPDynamicFolderItem* XUPProjectItemHelper::projectDynamicFolderItem( XUPProjectItem* project, bool create )
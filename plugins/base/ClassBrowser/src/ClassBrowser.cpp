@@ -113,6 +113,7 @@ qCtagsSenseProperties ClassBrowser::properties() const
     properties.FilteredSuffixes = settingsValue( "FilteredSuffixes", suffixes ).toStringList();
     properties.UsePhysicalDatabase = settingsValue( "UsePhysicalDatabase", false ).toBool();
     properties.DatabaseFileName = settingsValue( "DatabaseFileName", defaultDatabase() ).toString();
+    properties.IndexerWorkers = settingsValue( "IndexerWorkers", 0 ).toInt();
     
     return properties;
 }
@@ -125,6 +126,7 @@ void ClassBrowser::setProperties( const qCtagsSenseProperties& properties )
         setSettingsValue( "FilteredSuffixes", properties.FilteredSuffixes );
         setSettingsValue( "UsePhysicalDatabase", properties.UsePhysicalDatabase );
         setSettingsValue( "DatabaseFileName", properties.DatabaseFileName );
+        setSettingsValue( "IndexerWorkers", properties.IndexerWorkers );
         
         emit propertiesChanged( properties );
     }
@@ -206,7 +208,7 @@ void ClassBrowser::currentDocumentChanged( pAbstractChild* document )
 void ClassBrowser::opened( XUPProjectItem* project )
 {
     const QStringList files = project->topLevelProjectSourceFiles();
-    mDock->browser()->tagEntries( files );
+    mDock->browser()->tagProjectEntries( project->path(), files );
 }
 
 void ClassBrowser::buffersChanged( const QMap<QString, QString>& entries )
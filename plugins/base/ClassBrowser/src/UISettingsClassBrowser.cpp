@@ -36,6 +36,7 @@ UISettingsClassBrowser::UISettingsClassBrowser( ClassBrowser* plugin, QWidget* p
     
     ui->gbUseDBFileName->setChecked( properties.UsePhysicalDatabase );
     ui->leDBFileName->setText( properties.DatabaseFileName );
+    ui->sbIndexerWorkers->setValue( properties.IndexerWorkers );
     ui->pePaths->setValues( properties.SystemPaths );
     ui->sleSuffixes->setValues( properties.FilteredSuffixes );
 }
@@ -62,6 +63,7 @@ void UISettingsClassBrowser::on_dbbButtons_clicked( QAbstractButton* button )
     properties.FilteredSuffixes = ui->sleSuffixes->values();
     properties.UsePhysicalDatabase = ui->gbUseDBFileName->isChecked();
     properties.DatabaseFileName = ui->leDBFileName->text();
+    properties.IndexerWorkers = ui->sbIndexerWorkers->value();
     
     mPlugin->setIntegrationMode( (ClassBrowser::IntegrationMode)ui->cbIntegrationMode->itemData( ui->cbIntegrationMode->currentIndex() ).toInt() );
     mPlugin->setProperties( properties );
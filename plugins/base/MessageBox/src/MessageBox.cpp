@@ -69,6 +69,7 @@ bool MessageBox::install()
     
     // create docks
     mMessageBoxDocks = new MessageBoxDocks( this );
+    mMessageBoxDocks->setMaximumOutputLines( maximumOutputLines() );
     
     // add docks to main window
     MonkeyCore::mainWindow()->dockToolBar( Qt::BottomToolBarArea )->addDock( mMessageBoxDocks->mBuildStep, mMessageBoxDocks->mBuildStep->windowTitle(), mMessageBoxDocks->mBuildStep->windowIcon() );
@@ -126,6 +127,25 @@ bool MessageBox::uninstall()
 QWidget* MessageBox::settingsWidget() const
 { return new UIMessageBoxSettings( const_cast<MessageBox*>( this ) ); }
 
+/*!
+    Get the maximum number of lines kept by the Output dock
+    \return Number of lines, 0 means unlimited
+*/
+int MessageBox::maximumOutputLines() const
+{ return settingsValue( "MaximumOutputLines", 100000 ).toInt(); }
+
+/*!
+    Set the maximum number of lines kept by the Output dock
+    \param count Number of lines, 0 means unlimited
+    \param updateDock If true - the Output dock will be updated according with new count
+*/
+void MessageBox::setMaximumOutputLines( int count, bool updateDock )
+{
+    setSettingsValue( "MaximumOutputLines", count );
+    if ( updateDock && mMessageBoxDocks )
+        mMessageBoxDocks->setMaximumOutputLines( count );
+}
+
 void MessageBox::onConsoleStarted()
 {
     if ( settingsValue( "ActivateDock", true ).toBool() )
@@ -46,6 +46,9 @@ class MessageBox : public QObject, public BasePlugin
 
 public:
     virtual QWidget* settingsWidget() const;
+    
+    int maximumOutputLines() const;
+    void setMaximumOutputLines( int count, bool updateDock = false );
 
 protected:
     QPointer<MessageBoxDocks> mMessageBoxDocks;
@@ -76,7 +76,8 @@ bool pConsoleManagerStepModel::hasChildren( const QModelIndex& parent ) const
 
 QModelIndex pConsoleManagerStepModel::index( const pConsoleManagerStep& step ) const
 {
-    const int row = mSteps.indexOf( step );
+    // steps are mostly looked for while they are the last one
+    const int row = !mSteps.isEmpty() && mSteps.last() == step ? mSteps.count() -1 : mSteps.indexOf( step );
     return row == -1 ? QModelIndex() : createIndex( row, 0, &mSteps[ row ] );
 }
 
@@ -158,11 +159,10 @@ void pConsoleManagerStepModel::clear()
     endRemoveRows();
 }
 
-void pConsoleManagerStepModel::appendStep( const pConsoleManagerStep& step )
+void pConsoleManagerStepModel::applyStep( pConsoleManagerStepList& steps, const pConsoleManagerStep& step )
 {
     // get last type
-    const pConsoleManagerStep::Type type = mSteps.isEmpty() ? pConsoleManagerStep::Unknown : mSteps.last().type();
-    const int count = mSteps.count();
+    const pConsoleManagerStep::Type type = steps.isEmpty() ? pConsoleManagerStep::Unknown : steps.last().type();
     
     // update warnings/errors
     switch ( step.type() ) {
@@ -186,37 +186,27 @@ void pConsoleManagerStepModel::appendStep( const pConsoleManagerStep& step )
                 // insert before last item
                 case pConsoleManagerStep::Message:
                 case pConsoleManagerStep::Warning:
-                case pConsoleManagerStep::Error: {
-                    const int row = count -1;
-                    beginInsertRows( QModelIndex(), row, row );
-                    mSteps.insert( row, step );
-                    endInsertRows();
+                case pConsoleManagerStep::Error:
+                    steps.insert( steps.count() -1, step );
                     break;
-                }
                 // replace last item
-                default: {
-                    const int row = count -1;
-                    mSteps[ row ] = step;
-                    const QModelIndex index = this->index( step );
-                    emit dataChanged( index, index );
+                default:
+                    steps.last() = step;
                     break;
-                }
             }
             
             break;
         }
         // append item
         default: {
-            beginInsertRows( QModelIndex(), count, count );
-            mSteps << step;
-            endInsertRows();
+            steps << step;
             break;
         }
     }
     
     // if step is finish, need set error, warning, message texts if needed
     if ( step.type() == pConsoleManagerStep::Finish ) {
-        pConsoleManagerStep* _step = &mSteps.last();
+        pConsoleManagerStep* _step = &steps.last();
         
         if ( step.roleValue( Qt::DisplayRole ).toString().isEmpty() ) {
             _step->setRoleValue( pConsoleManagerStep::TypeRole, mErrors ? pConsoleManagerStep::Bad : pConsoleManagerStep::Good );
@@ -225,16 +215,43 @@ void pConsoleManagerStepModel::appendStep( const pConsoleManagerStep& step )
         else {
             _step->setRoleValue( pConsoleManagerStep::TypeRole, pConsoleManagerStep::Bad );
         }
-        
-        const QModelIndex idx = index( *_step );
-        emit dataChanged( idx, idx );
     }
 }
 
+void pConsoleManagerStepModel::appendStep( const pConsoleManagerStep& step )
+{
+    appendSteps( pConsoleManagerStepList() << step );
+}
+
 void pConsoleManagerStepModel::appendSteps( const pConsoleManagerStepList& steps )
 {
-    // do a hacky loop for now as this member is not yet used
+    if ( steps.isEmpty() ) {
+        return;
+    }
+    
+    const int count = mSteps.count();
+    // new steps can only change the last row, when it is an action, all others are appended
+    const bool hasAction = count > 0 && mSteps.last().type() == pConsoleManagerStep::Action;
+    pConsoleManagerStepList tail;
+    
+    if ( hasAction ) {
+        tail << mSteps.last();
+    }
+    
     foreach ( const pConsoleManagerStep& step, steps ) {
-        appendStep( step );
+        applyStep( tail, step );
+    }
+    
+    if ( hasAction ) {
+        const int row = count -1;
+        mSteps[ row ] = tail.takeFirst();
+        const QModelIndex index = createIndex( row, 0, &mSteps[ row ] );
+        emit dataChanged( index, index );
+    }
+    
+    if ( !tail.isEmpty() ) {
+        beginInsertRows( QModelIndex(), count, count +tail.count() -1 );
+        mSteps << tail;
+        endInsertRows();
     }
 }
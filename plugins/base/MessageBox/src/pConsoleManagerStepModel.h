@@ -58,6 +58,8 @@ protected:
     uint mMessages;
     uint mWarnings;
     uint mErrors;
+    
+    void applyStep( pConsoleManagerStepList& steps, const pConsoleManagerStep& step );
 };
 
 #endif // PCONSOLEMANAGERSTEPMODEL_H
@@ -27,6 +27,8 @@
 
 #include <QScrollBar>
 #include <QLineEdit>
+#include <QTimer>
+#include <QTextCodec>
 
 #include <coremanager/MonkeyCore.h>
 #include <workspace/pWorkspace.h>
@@ -54,12 +56,19 @@ MessageBoxDocks::MessageBoxDocks( QObject* parent )
     mOutput = new UIOutput;
     mStepModel = new pConsoleManagerStepModel( this );
     mBuildStep->lvBuildSteps->setModel( mStepModel );
+    mDecoder = QTextCodec::codecForLocale()->makeDecoder();
+    
+    // output is written at most once per frame, whatever the rate of the console
+    mFlushTimer = new QTimer( this );
+    mFlushTimer->setSingleShot( true );
+    mFlushTimer->setInterval( 40 );
     
     // set defaultshortcuts
     pActionsManager::setDefaultShortcut( mBuildStep->toggleViewAction(), QKeySequence( "F9" ) );
     pActionsManager::setDefaultShortcut( mOutput->toggleViewAction(), QKeySequence( "F10" ) );
     
     // connections
+    connect( mFlushTimer, SIGNAL( timeout() ), this, SLOT( flushOutput() ) );
     connect( mBuildStep->lvBuildSteps, SIGNAL( activated( const QModelIndex& ) ), this, SLOT( lvBuildSteps_activated( const QModelIndex& ) ) );
     connect( MonkeyCore::consoleManager(), SIGNAL( commandError( const pCommand&, QProcess::ProcessError ) ), this, SLOT( commandError( const pCommand&, QProcess::ProcessError ) ) );
     connect( MonkeyCore::consoleManager(), SIGNAL( commandFinished( const pCommand&, int, QProcess::ExitStatus ) ), this, SLOT( commandFinished( const pCommand&, int, QProcess::ExitStatus ) ) );
@@ -80,17 +89,65 @@ MessageBoxDocks::~MessageBoxDocks()
 {
     delete mBuildStep;
     delete mOutput;
+    delete mDecoder;
 }
 
 /*!
-    Make text colored by adding HTML tags before and after text
+    Get the maximum number of lines kept by the Output dock
+    \return Number of lines, 0 means unlimited
+*/
+int MessageBoxDocks::maximumOutputLines() const
+{ return mOutput->tbOutput->maximumBlockCount(); }
+
+/*!
+    Set the maximum number of lines kept by the Output dock
+
+    Once the limit is reached, the oldest lines are dropped when new ones are appended
+    \param count Number of lines, 0 means unlimited
+*/
+void MessageBoxDocks::setMaximumOutputLines( int count )
+{ mOutput->tbOutput->setMaximumBlockCount( count ); }
+
+/*!
+    Queue a run of plain text for the Output dock
+
+    Adjacent runs of the same colour are merged, the queue is written by flushOutput()
+    \param text Text to append
+    \param color Color of text, invalid for default color
+*/
+void MessageBoxDocks::appendRun( const QString& text, const QColor& color )
+{
+    if ( text.isEmpty() )
+    {
+        return;
+    }
+    
+    if ( !mPendingOutput.isEmpty() && mPendingOutput.last().color == color )
+    {
+        mPendingOutput.last().text.append( text );
+    }
+    else
+    {
+        OutputRun run;
+        run.text = text;
+        run.color = color;
+        mPendingOutput << run;
+    }
+    
+    if ( !mFlushTimer->isActive() )
+    {
+        mFlushTimer->start();
+    }
+}
 
-    \param s Source string
-    \param c Desired color
-    \return String, containing color tags at start and end
+/*!
+    Queue a line of stars used to frame commands informations
+    \param color Color of the line
 */
-QString MessageBoxDocks::colourText( const QString& s, const QColor& c )
-{ return QString( "<font color=\"%1\">%2</font>" ).arg( c.name() ).arg( s ); }
+void MessageBoxDocks::appendBoxBorder( const QColor& color )
+{
+    appendRun( QString( 80, QLatin1Char( '*' ) ).append( QLatin1Char( '\n' ) ), color );
+}
 
 /*!
     Append text to Output dock
@@ -98,17 +155,7 @@ QString MessageBoxDocks::colourText( const QString& s, const QColor& c )
 */
 void MessageBoxDocks::appendOutput( const QString& s )
 {
-    // we check if the scroll bar is at maximum
-    int p = mOutput->tbOutput->verticalScrollBar()->value();
-    bool b = p == mOutput->tbOutput->verticalScrollBar()->maximum();
-    // appendOutput text
-    mOutput->tbOutput->moveCursor( QTextCursor::End );
-    // QPlainTextEdit does not have an insertHtml member
-    QTextCursor cursor = mOutput->tbOutput->textCursor();
-    cursor.insertHtml( s +"<br />" );
-    mOutput->tbOutput->setTextCursor( cursor );
-    // if scrollbar is at maximum, increase it
-    mOutput->tbOutput->verticalScrollBar()->setValue( b ? mOutput->tbOutput->verticalScrollBar()->maximum() : p );
+    appendRun( s +QLatin1Char( '\n' ) );
 }
 
 /*!
@@ -117,17 +164,7 @@ void MessageBoxDocks::appendOutput( const QString& s )
 */
 void MessageBoxDocks::appendLog( const QString& s )
 {
-    // we check if the scroll bar is at maximum
-    int p = mOutput->tbOutput->verticalScrollBar()->value();
-    bool b = p == mOutput->tbOutput->verticalScrollBar()->maximum();
-    // appendOutput text
-    mOutput->tbOutput->moveCursor( QTextCursor::End );
-    // QPlainTextEdit does not have an insertHtml member
-    QTextCursor cursor = mOutput->tbOutput->textCursor();
-    cursor.insertHtml( s +"<br />" );
-    mOutput->tbOutput->setTextCursor( cursor );
-    // if scrollbar is at maximum, increase it
-    mOutput->tbOutput->verticalScrollBar()->setValue( b ? mOutput->tbOutput->verticalScrollBar()->maximum() : p );
+    appendRun( s +QLatin1Char( '\n' ) );
 }
 
 /*!
@@ -142,9 +179,52 @@ void MessageBoxDocks::appendLog( const QString& s )
 */
 void MessageBoxDocks::appendInBox( const QString& s, const QColor& c )
 {
-    appendLog( colourText( "********************************************************************************", c ) );
+    appendBoxBorder( c );
     appendLog( s );
-    appendLog( colourText( "********************************************************************************", c ) );
+    appendBoxBorder( c );
+}
+
+/*!
+    Write the queued text in the Output dock
+
+    All the pending runs are inserted as plain text in a single edit block, so a burst of
+    console output cost one layout and one repaint.
+*/
+void MessageBoxDocks::flushOutput()
+{
+    mFlushTimer->stop();
+    
+    if ( mPendingOutput.isEmpty() )
+    {
+        return;
+    }
+    
+    // we check if the scroll bar is at maximum
+    QScrollBar* sb = mOutput->tbOutput->verticalScrollBar();
+    const int oldValue = sb->value();
+    const bool atBottom = oldValue == sb->maximum();
+    
+    QTextCursor cursor( mOutput->tbOutput->document() );
+    cursor.movePosition( QTextCursor::End );
+    cursor.beginEditBlock();
+    
+    foreach ( const OutputRun& run, mPendingOutput )
+    {
+        QTextCharFormat format;
+        
+        if ( run.color.isValid() )
+        {
+            format.setForeground( run.color );
+        }
+        
+        cursor.insertText( run.text, format );
+    }
+    
+    cursor.endEditBlock();
+    mPendingOutput.clear();
+    
+    // restore position
+    sb->setValue( atBottom ? sb->maximum() : oldValue );
 }
 
 /*!
@@ -352,14 +432,16 @@ void MessageBoxDocks::lvBuildSteps_activated( const QModelIndex& index )
 */
 void MessageBoxDocks::commandError( const pCommand& command, QProcess::ProcessError error )
 {
-    QString s( tr( "* Error            : '%1'<br />" ).arg( colourText( command.text() ) ) );
-    s.append( tr( "* Command          : %1<br />" ).arg( colourText( command.command() ) ) );
-    s.append( tr( "* Working Directory: %1<br />" ).arg( colourText( command.workingDirectory() ) ) );
-    s.append( tr( "* Error            : #%1<br />" ).arg( colourText( QString::number( error ) ) ) );
-    s.append( colourText( pConsoleManager::errorToString( error ), Qt::darkGreen ) );
+    QString s( tr( "* Error            : '%1'" ).arg( command.text() ) +QLatin1Char( '\n' ) );
+    s.append( tr( "* Command          : %1" ).arg( command.command() ) +QLatin1Char( '\n' ) );
+    s.append( tr( "* Working Directory: %1" ).arg( command.workingDirectory() ) +QLatin1Char( '\n' ) );
+    s.append( tr( "* Error            : #%1" ).arg( error ) +QLatin1Char( '\n' ) );
 
     // appendOutput to console log
-    appendInBox( colourText( s, Qt::blue ), Qt::red );
+    appendBoxBorder( Qt::red );
+    appendRun( s, Qt::blue );
+    appendRun( pConsoleManager::errorToString( error ) +QLatin1Char( '\n' ), Qt::darkGreen );
+    appendBoxBorder( Qt::red );
     
     // append finish/error step
     pConsoleManagerStep::Data data;
@@ -378,19 +460,23 @@ void MessageBoxDocks::commandError( const pCommand& command, QProcess::ProcessEr
 */
 void MessageBoxDocks::commandFinished( const pCommand& c, int exitCode, QProcess::ExitStatus e )
 {
-    QString s( tr( "* Finished   : '%1'<br />" ).arg( colourText( c.text() ) ) );
-    s.append( tr( "* Exit Code  : #%1<br />" ).arg( colourText( QString::number( exitCode ) ) ) );
-    s.append( tr( "* Status Code: #%1<br />" ).arg( colourText( QString::number( e ) ) ) );
+    QString s( tr( "* Finished   : '%1'" ).arg( c.text() ) +QLatin1Char( '\n' ) );
+    s.append( tr( "* Exit Code  : #%1" ).arg( exitCode ) +QLatin1Char( '\n' ) );
+    s.append( tr( "* Status Code: #%1" ).arg( e ) +QLatin1Char( '\n' ) );
     //
+    QString status;
     if (e == QProcess::NormalExit && exitCode == 0)
-        s.append( colourText( tr( "The process exited normally." ), Qt::darkGreen ) );
+        status = tr( "The process exited normally." );
     else if (e == QProcess::CrashExit)
-        s.append( colourText( tr( "The process crashed." ), Qt::darkGreen ) );
+        status = tr( "The process crashed." );
     else
-        s.append( colourText( tr( "The exited with exit code %1" ).arg(exitCode), Qt::darkGreen ) );
+        status = tr( "The exited with exit code %1" ).arg(exitCode);
 
     // appendOutput to console log
-    appendInBox( colourText( s, Qt::blue ), Qt::red );
+    appendBoxBorder( Qt::red );
+    appendRun( s, Qt::blue );
+    appendRun( status +QLatin1Char( '\n' ), Qt::darkGreen );
+    appendBoxBorder( Qt::red );
     
     // append finish step
     pConsoleManagerStep::Data data;
@@ -408,32 +494,14 @@ void MessageBoxDocks::commandFinished( const pCommand& c, int exitCode, QProcess
 /*!
     Handler of Ready Read event from runned command.
 
-    Appends text, readed from process to Output dock
+    Appends text, readed from process to Output dock.
+    The decoder keeps its state between calls so a character split across two chunks
+    is decoded correctly.
     \param a Text in the QByteArray format
 */
 void MessageBoxDocks::commandReadyRead( const pCommand&, const QByteArray& a )
 {
-    // we check if the scroll bar is at maximum
-    QScrollBar* sb = mOutput->tbOutput->verticalScrollBar();
-    const int oldValue = sb->value();
-    bool atBottom = oldValue == sb->maximum();
-    
-    // appendOutput log
-    mOutput->tbOutput->moveCursor( QTextCursor::End );
-    /*
-    QTextCursor cursor = mOutput->tbOutput->textCursor();
-    QTextCharFormat format = cursor.blockCharFormat();
-    if ( format.foreground().color() != QColor( Qt::black ) )
-    {
-        format.setForeground( QBrush( Qt::black ) );
-        cursor.setBlockCharFormat( format );
-        mOutput->tbOutput->setTextCursor( cursor );
-    }
-    */
-    mOutput->tbOutput->insertPlainText( QTextCodec::codecForLocale()->toUnicode( a ) );
-    
-    // restore position
-    sb->setValue( atBottom ? sb->maximum() : oldValue );
+    appendRun( mDecoder->toUnicode( a ) );
 }
 
 /*!
@@ -444,11 +512,13 @@ void MessageBoxDocks::commandReadyRead( const pCommand&, const QByteArray& a )
 */
 void MessageBoxDocks::commandStarted( const pCommand& c )
 {
-    QString s( tr( "* Started          : '%1'<br />" ).arg( colourText( c.text() ) ) );
-    s.append( tr( "* Command          : %1<br />" ).arg( colourText( c.command() ) ) );
-    s.append( tr( "* Working Directory: %1" ).arg( colourText( c.workingDirectory() ) ) );
+    QString s( tr( "* Started          : '%1'" ).arg( c.text() ) +QLatin1Char( '\n' ) );
+    s.append( tr( "* Command          : %1" ).arg( c.command() ) +QLatin1Char( '\n' ) );
+    s.append( tr( "* Working Directory: %1" ).arg( c.workingDirectory() ) +QLatin1Char( '\n' ) );
     // appendOutput to console log
-    appendInBox( colourText( s, Qt::blue ), Qt::red );
+    appendBoxBorder( Qt::red );
+    appendRun( s, Qt::blue );
+    appendBoxBorder( Qt::red );
 }
 
 /*!
@@ -470,16 +540,18 @@ void MessageBoxDocks::commandStateChanged( const pCommand& c, QProcess::ProcessS
             ss = tr( "Starting" );
             // clear all tabs
             mStepModel->clear();
+            mPendingOutput.clear();
             mOutput->tbOutput->clear();
-            mOutput->tbOutput->clear();
+            delete mDecoder;
+            mDecoder = QTextCodec::codecForLocale()->makeDecoder();
             break;
         case QProcess::Running:
             ss = tr( "Running" );
             break;
     }
     // appendOutput to console log
-    appendOutput( colourText( tr( "*** State changed to %1" ).arg( ss ), Qt::gray ) );
-    appendLog( colourText( tr( "*** State changed to #%1 (%2) for command: '%3'" ).arg( s ).arg( ss ).arg( c.text() ), Qt::gray ) );
+    appendRun( tr( "*** State changed to %1" ).arg( ss ) +QLatin1Char( '\n' ), Qt::gray );
+    appendRun( tr( "*** State changed to #%1 (%2) for command: '%3'" ).arg( s ).arg( ss ).arg( c.text() ) +QLatin1Char( '\n' ), Qt::gray );
 }
 
 /*!
@@ -490,10 +562,12 @@ void MessageBoxDocks::commandStateChanged( const pCommand& c, QProcess::ProcessS
 */
 void MessageBoxDocks::commandSkipped( const pCommand& c )
 {
-    QString s( tr( "* Skipped          : '%1'<br />" ).arg( colourText( c.text() ) ) );
-    s.append( tr( "* Command          : %1<br />" ).arg( colourText( c.command() ) ) );
-    s.append( tr( "* Working Directory: %1" ).arg( colourText( c.workingDirectory() ) ) );
-    s.append( colourText( tr( "The command has been skipped due to previous error." ), Qt::darkGreen ) );
+    QString s( tr( "* Skipped          : '%1'" ).arg( c.text() ) +QLatin1Char( '\n' ) );
+    s.append( tr( "* Command          : %1" ).arg( c.command() ) +QLatin1Char( '\n' ) );
+    s.append( tr( "* Working Directory: %1" ).arg( c.workingDirectory() ) +QLatin1Char( '\n' ) );
     // appendOutput to console log
-    appendInBox( colourText( s, Qt::blue ), Qt::red );
+    appendBoxBorder( Qt::red );
+    appendRun( s, Qt::blue );
+    appendRun( tr( "The command has been skipped due to previous error." ) +QLatin1Char( '\n' ), Qt::darkGreen );
+    appendBoxBorder( Qt::red );
 }
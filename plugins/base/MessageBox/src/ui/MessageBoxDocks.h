@@ -39,6 +39,8 @@
 #include <pMenuBar.h>
 
 class pConsoleManagerStepModel;
+class QTimer;
+class QTextDecoder;
 
 /*!
     Implementation of Build Steps tab of Message box
@@ -99,17 +101,35 @@ public:
     MessageBoxDocks( QObject* parent = 0 );
     ~MessageBoxDocks();
     
-    QString colourText( const QString&, const QColor& = Qt::black );
+    int maximumOutputLines() const;
+    void setMaximumOutputLines( int count );
 
 protected:
+    /*!
+        A run of text sharing the same colour, waiting to be written in the Output dock.
+        An invalid colour means the default text colour.
+    */
+    struct OutputRun
+    {
+        QString text;
+        QColor color;
+    };
+    
     UIBuildStep* mBuildStep;
     UIOutput* mOutput;
     pConsoleManagerStepModel* mStepModel;
+    QList<OutputRun> mPendingOutput;
+    QTimer* mFlushTimer;
+    QTextDecoder* mDecoder;
+    
+    void appendRun( const QString& text, const QColor& color = QColor() );
+    void appendBoxBorder( const QColor& color );
 
 public slots:
     void appendOutput( const QString& );
     void appendLog( const QString& );
     void appendInBox( const QString&, const QColor& = Qt::red );
+    void flushOutput();
     void appendStep( const pConsoleManagerStep& step );
     void appendSteps( const pConsoleManagerStepList& steps );
     void showBuild();
@@ -52,6 +52,7 @@ UIMessageBoxSettings::UIMessageBoxSettings( MessageBox* plugin, QWidget* parent
     gbActivateDock->setChecked( mPlugin->settingsValue( "ActivateDock", true ).toBool() );
     UIMessageBoxSettings::Dock dock = (UIMessageBoxSettings::Dock)mPlugin->settingsValue( "ActivatedDock", UIMessageBoxSettings::Output ).toInt();
     cbActivateDock->setCurrentIndex( cbActivateDock->findData( dock ) );
+    sbMaximumOutputLines->setValue( mPlugin->maximumOutputLines() );
 }
 
 /*!
@@ -65,17 +66,19 @@ void UIMessageBoxSettings::on_dbbButtons_clicked( QAbstractButton* button )
 {
     if ( button == dbbButtons->button( QDialogButtonBox::Help ) )
     {
-        const QString help = tr( "You can activate a special Message Box dock when console is started, for this check the box and choose witch dock to activate." );
+        const QString help = tr( "You can activate a special Message Box dock when console is started, for this check the box and choose witch dock to activate.<br />The Output dock keeps only the last lines of the console output, set the maximum to 0 to keep them all." );
         QWhatsThis::showText( mapToGlobal( rect().center() ), help, this ) ;
     }
     else if ( button == dbbButtons->button( QDialogButtonBox::RestoreDefaults ) )
     {
         gbActivateDock->setChecked( true );
         cbActivateDock->setCurrentIndex( cbActivateDock->findData( UIMessageBoxSettings::Output ) );
+        sbMaximumOutputLines->setValue( 100000 );
     }
     else if ( button == dbbButtons->button( QDialogButtonBox::Apply ) )
     {
         mPlugin->setSettingsValue( "ActivateDock", gbActivateDock->isChecked() );
         mPlugin->setSettingsValue( "ActivatedDock", cbActivateDock->itemData( cbActivateDock->currentIndex() ).toInt() );
+        mPlugin->setMaximumOutputLines( sbMaximumOutputLines->value(), true );
     }
 }
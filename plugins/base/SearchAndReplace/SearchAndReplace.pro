@@ -24,6 +24,9 @@ FORMS   = src/SearchWidget.ui \
 
 HEADERS = src/SearchAndReplace.h \
     src/SearchThread.h \
+    src/SearchWorker.h \
+    src/SearchBenchmark.h \
+    src/SearchFileSource.h \
     src/ReplaceThread.h \
     src/SearchWidget.h \
     src/SearchResultsDock.h \
@@ -32,6 +35,9 @@ HEADERS = src/SearchAndReplace.h \
 
 SOURCES = src/SearchAndReplace.cpp \
     src/SearchThread.cpp \
+    src/SearchWorker.cpp \
+    src/SearchBenchmark.cpp \
+    src/SearchFileSource.cpp \
     src/ReplaceThread.cpp \
     src/SearchWidget.cpp \
     src/SearchResultsDock.cpp \
@@ -17,7 +17,7 @@
     Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
 ****************************************************************************/
 #include "ReplaceThread.h"
-#include "SearchWidget.h"
+#include "SearchFileSource.h"
 
 #include <QMutexLocker>
 #include <QTextCodec>
@@ -106,19 +106,14 @@ QString ReplaceThread::fileContent( const QString& fileName ) const
 
     Q_ASSERT( codec );
 
-    QFile file( fileName );
-
-    if ( !file.open( QIODevice::ReadOnly ) )
-    {
-        return QString::null;
-    }
+    SearchFileSource source( fileName );
 
-    if ( SearchWidget::isBinary( file ) )
+    if ( !source.open() || source.isBinary() )
     {
         return QString::null;
     }
 
-    return codec->toUnicode( file.readAll() );
+    return source.content( codec );
 }
 
 void ReplaceThread::replace( const QString& fileName, QString content )
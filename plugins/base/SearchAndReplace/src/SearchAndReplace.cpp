@@ -20,11 +20,13 @@
 #include "SearchAndReplaceSettings.h"
 #include "SearchWidget.h"
 #include "SearchResultsDock.h"
+#include "SearchBenchmark.h"
 
 #include <coremanager/MonkeyCore.h>
 #include <workspace/pWorkspace.h>
 #include <workspace/pAbstractChild.h>
 #include <maininterface/UIMain.h>
+#include <shellmanager/MkSShellInterpreter.h>
 #include <pIconManager.h>
 #include <pDockToolBar.h>
 #include <pMenuBar.h>
@@ -42,6 +44,7 @@ SearchAndReplace::Settings SearchAndReplace::settings() const
     settings.onlyWhenNotVisible = settingsValue( "onlyWhenNotVisible", settings.onlyWhenNotVisible ).toBool();
     settings.onlyWhenNotRegExp = settingsValue( "onlyWhenNotRegExp", settings.onlyWhenNotRegExp ).toBool();
     settings.onlyWhenNotEmpty = settingsValue( "onlyWhenNotEmpty", settings.onlyWhenNotEmpty ).toBool();
+    settings.searchWorkers = settingsValue( "searchWorkers", settings.searchWorkers ).toInt();
     
     return settings;
 }
@@ -52,6 +55,7 @@ void SearchAndReplace::setSettings( const SearchAndReplace::Settings& settings )
     setSettingsValue( "onlyWhenNotVisible", settings.onlyWhenNotVisible );
     setSettingsValue( "onlyWhenNotRegExp", settings.onlyWhenNotRegExp );
     setSettingsValue( "onlyWhenNotEmpty", settings.onlyWhenNotEmpty );
+    setSettingsValue( "searchWorkers", settings.searchWorkers );
 }
 
 void SearchAndReplace::fillPluginInfos()
@@ -113,12 +117,22 @@ bool SearchAndReplace::install()
         action = mb->action( "aReplaceOpenedFiles", tr( "Replace in Open&ed Files..." ), pIconManager::icon( "search-replace-opened-files.png" ), tr( "Ctrl+Alt+Meta+R" ), tr( "Replace in opened files..." ) );
         connect( action, SIGNAL( triggered() ), this, SLOT( replaceOpenedFiles_triggered() ) );
     mb->endGroup();
+    
+    const QString help = MkSShellInterpreter::tr(
+        "This command time the searches, usage:\n"
+        "\tsearch benchmark [path] [text] [workers]\n"
+        "The text is searched in the path with one thread, then with the given workers (0 = one per core)"
+    );
+    
+    MonkeyCore::interpreter()->addCommandImplementation( "search", SearchBenchmark::commandInterpreter, help, this );
 
     return true;
 }
 
 bool SearchAndReplace::uninstall()
 {
+    MonkeyCore::interpreter()->removeCommandImplementation( "search" );
+    
     pMenuBar* mb = MonkeyCore::menuBar();
     QAction* action;
 
@@ -74,12 +74,14 @@ public:
             onlyWhenNotVisible = false;
             onlyWhenNotRegExp = true;
             onlyWhenNotEmpty = true;
+            searchWorkers = 0;
         }
         
         bool replaceSearchText;
         bool onlyWhenNotVisible;
         bool onlyWhenNotRegExp;
         bool onlyWhenNotEmpty;
+        int searchWorkers; // 0 = one per core, 1 = no worker threads
     };
     
     struct Properties
@@ -39,6 +39,7 @@ void SearchAndReplaceSettings::loadSettings( const SearchAndReplace::Settings& s
     cbOnlyWhenNotVisible->setChecked( settings.onlyWhenNotVisible );
     cbOnlyWhenNotRegExp->setChecked( settings.onlyWhenNotRegExp );
     cbOnlyWhenNotEmpty->setChecked( settings.onlyWhenNotEmpty );
+    sbSearchWorkers->setValue( settings.searchWorkers );
 }
 
 void SearchAndReplaceSettings::restoreDefault()
@@ -59,6 +60,7 @@ void SearchAndReplaceSettings::accept()
     settings.onlyWhenNotVisible = cbOnlyWhenNotVisible->isChecked();
     settings.onlyWhenNotRegExp = cbOnlyWhenNotRegExp->isChecked();
     settings.onlyWhenNotEmpty = cbOnlyWhenNotEmpty->isChecked();
+    settings.searchWorkers = sbSearchWorkers->value();
     
     mPlugin->setSettings( settings );
     
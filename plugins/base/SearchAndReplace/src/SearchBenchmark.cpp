@@ -0,0 +1,168 @@
+/****************************************************************************
+    Copyright (C) 2005 - 2011  Filipe AZEVEDO & The Monkey Studio Team
+    http://monkeystudio.org licensing under the GNU GPL.
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+****************************************************************************/
+#include "SearchBenchmark.h"
+#include "SearchThread.h"
+
+#include <shellmanager/MkSShellInterpreter.h>
+#include <pMonkeyStudio.h>
+
+#include <QDir>
+
+SearchBenchmark::SearchBenchmark( QObject* parent )
+    : QObject( parent )
+{
+    mResults = 0;
+    mFirstResults = -1;
+    mLastResults = 0;
+    mLongestWait = 0;
+}
+
+QString SearchBenchmark::exec( const QString& path, const QString& text, int workers )
+{
+    SearchAndReplace::Properties properties;
+    properties.searchText = text;
+    properties.searchPath = QDir( path ).absolutePath();
+    properties.mode = SearchAndReplace::ModeSearchDirectory;
+    properties.codec = pMonkeyStudio::defaultCodec();
+    properties.options = SearchAndReplace::OptionCaseSensitive;
+    
+    QStringList output;
+    
+    // the first search fills the system cache so both paths read the files from memory
+    search( properties, 1 );
+    
+    output << tr( "Searching '%1' in %2" ).arg( text ).arg( properties.searchPath );
+    output << search( properties, 1 );
+    output << search( properties, workers );
+    
+    return output.join( "\n" );
+}
+
+QString SearchBenchmark::commandInterpreter( const QString& command, const QStringList& _arguments, int* result, MkSShellInterpreter* interpreter, void* data )
+{
+    Q_UNUSED( command );
+    Q_UNUSED( interpreter );
+    Q_UNUSED( data );
+    QStringList arguments = _arguments;
+    const QStringList allowedOperations = QStringList( "benchmark" );
+    
+    if ( result )
+    {
+        *result = MkSShellInterpreter::NoError;
+    }
+    
+    if ( arguments.isEmpty() )
+    {
+        if ( result )
+        {
+            *result = MkSShellInterpreter::InvalidCommand;
+        }
+        
+        return MkSShellInterpreter::tr( "Operation not defined. Available operations are: %1." ).arg( allowedOperations.join( ", " ) );
+    }
+    
+    const QString operation = arguments.takeFirst();
+    
+    if ( !allowedOperations.contains( operation ) )
+    {
+        if ( result )
+        {
+            *result = MkSShellInterpreter::InvalidCommand;
+        }
+        
+        return MkSShellInterpreter::tr( "Unknown operation: '%1'." ).arg( operation );
+    }
+    
+    if ( operation == "benchmark" )
+    {
+        if ( arguments.count() != 2 && arguments.count() != 3 )
+        {
+            if ( result )
+            {
+                *result = MkSShellInterpreter::InvalidCommand;
+            }
+            
+            return MkSShellInterpreter::tr( "'benchmark' operation take 2 or 3 arguments, %1 given." ).arg( arguments.count() );
+        }
+        
+        const QString path = arguments.at( 0 );
+        const QString text = arguments.at( 1 );
+        const int workers = arguments.value( 2, "0" ).toInt();
+        
+        if ( !QFileInfo( path ).isDir() || text.isEmpty() )
+        {
+            if ( result )
+            {
+                *result = MkSShellInterpreter::InvalidCommand;
+            }
+            
+            return MkSShellInterpreter::tr( "'benchmark' operation needs an existing directory and a text to search." );
+        }
+        
+        SearchBenchmark benchmark;
+        return benchmark.exec( path, text, workers );
+    }
+    
+    return QString::null;
+}
+
+QString SearchBenchmark::search( SearchAndReplace::Properties properties, int workers )
+{
+    SearchThread thread;
+    properties.settings.searchWorkers = workers;
+    
+    // the results are counted and freed in the searching thread, nothing is read before it finishes
+    connect( &thread, SIGNAL( resultsAvailable( const QString&, const SearchResultsModel::ResultList& ) ), this, SLOT( thread_resultsAvailable( const QString&, const SearchResultsModel::ResultList& ) ), Qt::DirectConnection );
+    
+    mResults = 0;
+    mFirstResults = -1;
+    mLastResults = 0;
+    mLongestWait = 0;
+    mTracker.start();
+    
+    thread.search( properties );
+    thread.wait();
+    
+    const int elapsed = mTracker.elapsed();
+    const QString label = workers == 1 ? tr( "single thread" ) : tr( "workers pool (%1)" ).arg( workers <= 0 ? QThread::idealThreadCount() : workers );
+    
+    return tr( "%1: %2 results in %3 ms, first results after %4 ms, longest wait for results %5 ms" )
+        .arg( label )
+        .arg( mResults )
+        .arg( elapsed )
+        .arg( mFirstResults )
+        .arg( qMax( mLongestWait, elapsed -mLastResults ) );
+}
+
+void SearchBenchmark::thread_resultsAvailable( const QString& fileName, const SearchResultsModel::ResultList& results )
+{
+    Q_UNUSED( fileName );
+    const int elapsed = mTracker.elapsed();
+    
+    if ( mFirstResults == -1 )
+    {
+        mFirstResults = elapsed;
+    }
+    
+    mLongestWait = qMax( mLongestWait, elapsed -mLastResults );
+    mLastResults = elapsed;
+    mResults += results.count();
+    
+    qDeleteAll( results );
+}
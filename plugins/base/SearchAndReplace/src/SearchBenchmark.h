@@ -0,0 +1,59 @@
+/****************************************************************************
+    Copyright (C) 2005 - 2011  Filipe AZEVEDO & The Monkey Studio Team
+    http://monkeystudio.org licensing under the GNU GPL.
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+****************************************************************************/
+#ifndef SEARCHBENCHMARK_H
+#define SEARCHBENCHMARK_H
+
+#include <QObject>
+#include <QTime>
+
+#include "SearchAndReplace.h"
+#include "SearchResultsModel.h"
+
+class MkSShellInterpreter;
+
+/*
+    Time the SearchThread searches of a directory with the single threaded path and with the workers pool.
+    Besides the total time, it reports how long the results take to come, the workers must keep handing back
+    the results of big files while searching them.
+*/
+class SearchBenchmark : public QObject
+{
+    Q_OBJECT
+    
+public:
+    SearchBenchmark( QObject* parent = 0 );
+    
+    QString exec( const QString& path, const QString& text, int workers );
+    
+    static QString commandInterpreter( const QString& command, const QStringList& arguments, int* result, MkSShellInterpreter* interpreter, void* data );
+
+protected:
+    QTime mTracker;
+    int mResults;
+    int mFirstResults; // msecs from the start
+    int mLastResults; // msecs from the start
+    int mLongestWait; // msecs between two results emissions
+    
+    QString search( SearchAndReplace::Properties properties, int workers );
+
+protected slots:
+    void thread_resultsAvailable( const QString& fileName, const SearchResultsModel::ResultList& results );
+};
+
+#endif // SEARCHBENCHMARK_H
@@ -0,0 +1,156 @@
+/****************************************************************************
+    Copyright (C) 2005 - 2011  Filipe AZEVEDO & The Monkey Studio Team
+    http://monkeystudio.org licensing under the GNU GPL.
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+****************************************************************************/
+#include "SearchFileSource.h"
+
+#include <QByteArrayMatcher>
+#include <QTextCodec>
+
+#include <cstring>
+
+// QString can't hold more
+static const qint64 MaximumSize = 0x7fffffff;
+// size of the header checked for binary content
+static const qint64 BinaryHeaderSize = 1024;
+
+static inline char asciiLower( char c )
+{
+    return c >= 'A' && c <= 'Z' ? c +( 'a' -'A' ) : c;
+}
+
+SearchFileSource::SearchFileSource( const QString& fileName )
+    : mFile( fileName )
+{
+    mData = 0;
+    mSize = 0;
+}
+
+bool SearchFileSource::open()
+{
+    if ( !mFile.open( QIODevice::ReadOnly ) )
+    {
+        return false;
+    }
+    
+    mSize = mFile.size();
+    
+    if ( mSize > 0 )
+    {
+        mData = reinterpret_cast<const char*>( mFile.map( 0, mSize ) );
+        
+        // not mappable (special files, some file systems), fall back to a copy
+        if ( !mData )
+        {
+            mBuffer = mFile.readAll();
+            mData = mBuffer.constData();
+            mSize = mBuffer.size();
+        }
+    }
+    
+    return true;
+}
+
+bool SearchFileSource::isBinary() const
+{
+    return isBinary( mData, mSize );
+}
+
+bool SearchFileSource::mayContain( const QString& text, Qt::CaseSensitivity sensitivity, QTextCodec* codec ) const
+{
+    if ( text.isEmpty() || !codec )
+    {
+        return true;
+    }
+    
+    QByteArray bytes = text.toLatin1();
+    
+    // only ascii text encoded as is by the codec can be searched in the raw bytes
+    for ( int i = 0; i < text.length(); i++ )
+    {
+        const ushort c = text.at( i ).unicode();
+        
+        if ( c > 0x7f )
+        {
+            return true;
+        }
+        
+        // U+212A KELVIN SIGN and U+017F LATIN SMALL LETTER LONG S case fold to ascii letters
+        if ( sensitivity == Qt::CaseInsensitive && ( c == 'k' || c == 'K' || c == 's' || c == 'S' ) )
+        {
+            return true;
+        }
+    }
+    
+    if ( codec->fromUnicode( text ) != bytes )
+    {
+        return true;
+    }
+    
+    if ( mSize > MaximumSize )
+    {
+        return true;
+    }
+    
+    if ( sensitivity == Qt::CaseSensitive )
+    {
+        return QByteArrayMatcher( bytes ).indexIn( mData, int( mSize ) ) != -1;
+    }
+    
+    bytes = bytes.toLower();
+    const char* pattern = bytes.constData();
+    const int length = bytes.length();
+    const char first = pattern[ 0 ];
+    const char firstUpper = first >= 'a' && first <= 'z' ? first -( 'a' -'A' ) : first;
+    
+    for ( qint64 i = 0; i <= mSize -length; i++ )
+    {
+        if ( mData[ i ] != first && mData[ i ] != firstUpper )
+        {
+            continue;
+        }
+        
+        int j = 1;
+        
+        while ( j < length && asciiLower( mData[ i +j ] ) == pattern[ j ] )
+        {
+            j++;
+        }
+        
+        if ( j == length )
+        {
+            return true;
+        }
+    }
+    
+    return false;
+}
+
+QString SearchFileSource::content( QTextCodec* codec ) const
+{
+    if ( !mData || mSize > MaximumSize )
+    {
+        return QString::null;
+    }
+    
+    return codec->toUnicode( mData, int( mSize ) );
+}
+
+bool SearchFileSource::isBinary( const char* data, qint64 size )
+{
+    return data && memchr( data, '\0', size_t( qMin( size, BinaryHeaderSize ) ) );
+}
@@ -0,0 +1,52 @@
+/****************************************************************************
+    Copyright (C) 2005 - 2011  Filipe AZEVEDO & The Monkey Studio Team
+    http://monkeystudio.org licensing under the GNU GPL.
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+****************************************************************************/
+#ifndef SEARCHFILESOURCE_H
+#define SEARCHFILESOURCE_H
+
+#include <QFile>
+#include <QByteArray>
+
+class QTextCodec;
+
+/*
+    Read only access to a file searched or replaced by the threads.
+    The file is memory mapped when possible, so its bytes are checked and decoded in place
+    instead of being copied in a QByteArray first.
+*/
+class SearchFileSource
+{
+public:
+    SearchFileSource( const QString& fileName );
+    
+    bool open();
+    bool isBinary() const;
+    // return false only if the file can't contain text, undecidable cases return true
+    bool mayContain( const QString& text, Qt::CaseSensitivity sensitivity, QTextCodec* codec ) const;
+    QString content( QTextCodec* codec ) const;
+    
+    static bool isBinary( const char* data, qint64 size );
+
+protected:
+    QFile mFile;
+    QByteArray mBuffer; // the content when the file can't be mapped
+    const char* mData;
+    qint64 mSize;
+};
+
+#endif // SEARCHFILESOURCE_H
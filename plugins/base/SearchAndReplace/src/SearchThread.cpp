@@ -17,8 +17,11 @@
     Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
 ****************************************************************************/
 #include "SearchThread.h"
+#include "SearchWorker.h"
+#include "SearchFileSource.h"
 
 #include <QMutexLocker>
+#include <QStringMatcher>
 #include <QTextCodec>
 #include <QTime>
 #include <QTimer>
@@ -26,11 +29,47 @@
 
 int SearchThread::mMaxTime = 125;
 
+static bool isWordCharacter( const QChar& c )
+{
+    return c.isLetterOrNumber() || c.isMark() || c == QLatin1Char( '_' );
+}
+
+// find the next literal occurrence, whole word matches follow the \b semantic of QRegExp
+static int literalIndexIn( const QStringMatcher& matcher, const QString& content, int from, bool wholeWord )
+{
+    const QString pattern = matcher.pattern();
+    const bool wordStart = isWordCharacter( pattern.at( 0 ) );
+    const bool wordEnd = isWordCharacter( pattern.at( pattern.length() -1 ) );
+    int pos = from;
+    
+    while ( ( pos = matcher.indexIn( content, pos ) ) != -1 )
+    {
+        if ( !wholeWord )
+        {
+            return pos;
+        }
+        
+        const int end = pos +pattern.length();
+        const bool before = pos > 0 && isWordCharacter( content.at( pos -1 ) );
+        const bool after = end < content.length() && isWordCharacter( content.at( end ) );
+        
+        if ( before != wordStart && after != wordEnd )
+        {
+            return pos;
+        }
+        
+        pos++;
+    }
+    
+    return -1;
+}
+
 SearchThread::SearchThread( QObject* parent )
     : QThread( parent )
 {
     mReset = false;
     mExit = false;
+    mNextFileToSearch = 0;
 
     qRegisterMetaType<SearchResultsModel::ResultList>( "SearchResultsModel::ResultList" );
 }
@@ -71,6 +110,12 @@ SearchAndReplace::Properties* SearchThread::properties() const
     return &const_cast<SearchThread*>( this )->mProperties;
 }
 
+bool SearchThread::isCanceled() const
+{
+    QMutexLocker locker( const_cast<QMutex*>( &mMutex ) );
+    return mReset || mExit;
+}
+
 QStringList SearchThread::getFiles( QDir fromDir, const QStringList& filters, bool recursive ) const
 {
     QStringList files;
@@ -203,6 +248,9 @@ QStringList SearchThread::getFilesToScan() const
 QString SearchThread::fileContent( const QString& fileName ) const
 {
     QTextCodec* codec = 0;
+    QString text;
+    bool isRE = false;
+    Qt::CaseSensitivity sensitivity = Qt::CaseInsensitive;
 
     {
         QMutexLocker locker( const_cast<QMutex*>( &mMutex ) );
@@ -213,101 +261,298 @@ QString SearchThread::fileContent( const QString& fileName ) const
         {
             return mProperties.openedFiles[ fileName ];
         }
+        
+        text = mProperties.searchText;
+        isRE = mProperties.options & SearchAndReplace::OptionRegularExpression;
+        sensitivity = mProperties.options & SearchAndReplace::OptionCaseSensitive ? Qt::CaseSensitive : Qt::CaseInsensitive;
     }
 
     Q_ASSERT( codec );
 
-    QFile file( fileName );
+    SearchFileSource source( fileName );
 
-    if ( !file.open( QIODevice::ReadOnly ) )
+    if ( !source.open() || source.isBinary() )
     {
         return QString::null;
     }
     
-    if ( SearchWidget::isBinary( file ) )
+    // files that can't contain the searched text are not decoded
+    if ( !isRE && !source.mayContain( text, sensitivity, codec ) )
     {
         return QString::null;
     }
 
-    return codec->toUnicode( file.readAll() );
+    return source.content( codec );
 }
 
-void SearchThread::search( const QString& fileName, const QString& content ) const
+// index is the file index in the workers pipeline, -1 when the file is searched by this thread
+void SearchThread::search( int index, const QString& fileName, const QString& content, SearchResultsModel::ResultList& results ) const
 {
-    static const QString eol( "\n" );
+    static const QChar eol = QLatin1Char( '\n' );
     bool checkable = false;
     bool isRE = false;
+    bool isWw = false;
     QRegExp rx;
+    QStringMatcher matcher;
     
     {
         QMutexLocker locker( const_cast<QMutex*>( &mMutex ) );
 
         isRE = mProperties.options & SearchAndReplace::OptionRegularExpression;
-        const bool isWw = mProperties.options & SearchAndReplace::OptionWholeWord;
+        isWw = mProperties.options & SearchAndReplace::OptionWholeWord;
         const bool isCS = mProperties.options & SearchAndReplace::OptionCaseSensitive;
         const Qt::CaseSensitivity sensitivity = isCS ? Qt::CaseSensitive : Qt::CaseInsensitive;
         checkable = mProperties.mode & SearchAndReplace::ModeFlagReplace;
-        QString pattern = isRE ? mProperties.searchText : QRegExp::escape( mProperties.searchText );
+        
+        if ( isRE )
+        {
+            QString pattern = mProperties.searchText;
 
-        if ( isWw )
+            if ( isWw )
+            {
+                pattern.prepend( "\\b" ).append( "\\b" );
+            }
+
+            rx.setMinimal( true );
+            rx.setPattern( pattern );
+            rx.setCaseSensitivity( sensitivity );
+        }
+        // plain text searches don't need the regexp engine
+        else
         {
-            pattern.prepend( "\\b" ).append( "\\b" );
+            matcher.setPattern( mProperties.searchText );
+            matcher.setCaseSensitivity( sensitivity );
         }
-
-        rx.setMinimal( true );
-        rx.setPattern( pattern );
-        rx.setCaseSensitivity( sensitivity );
     }
     
+    if ( !isRE && matcher.pattern().isEmpty() )
+    {
+        return;
+    }
+    
+    const QChar* data = content.unicode();
     int pos = 0;
-    int lastPos = 0;
-    int eolCount = 0;
-    SearchResultsModel::ResultList results;
+    int scanned = 0; // the content before this offset has been scanned for eols
+    int line = 0;
+    int lineStart = 0;
+    int captureStart = -1;
+    QString capture;
     QTime tracker;
-
+    
     tracker.start();
 
-    while ( ( pos = rx.indexIn( content, pos ) ) != -1 )
+    while ( ( pos = isRE ? rx.indexIn( content, pos ) : literalIndexIn( matcher, content, pos, isWw ) ) != -1 )
     {
-        const int eolStart = content.lastIndexOf( eol, pos );
-        const int eolEnd = content.indexOf( eol, pos );
-        const QString capture = content.mid( eolStart + 1, eolEnd -1 -eolStart ).simplified();
-        eolCount += content.mid( lastPos, pos -lastPos ).count( eol );
-        const int column = ( pos -eolStart ) -( eolStart != 0 ? 1 : 0 );
+        const int length = isRE ? rx.matchedLength() : matcher.pattern().length();
+        
+        // track the line of the match, each character is only visited once per file
+        for ( ; scanned < pos; scanned++ )
+        {
+            if ( data[ scanned ] == eol )
+            {
+                line++;
+                lineStart = scanned +1;
+            }
+        }
+        
+        // matches on the same line share their capture
+        if ( captureStart != lineStart )
+        {
+            int lineEnd = content.indexOf( eol, pos );
+            
+            if ( lineEnd == -1 )
+            {
+                lineEnd = content.length();
+            }
+            
+            captureStart = lineStart;
+            capture = QString::fromRawData( data +lineStart, lineEnd -lineStart ).simplified();
+        }
+        
         SearchResultsModel::Result* result = new SearchResultsModel::Result( fileName, capture );
-        result->position = QPoint( column, eolCount );
+        result->position = QPoint( pos -lineStart, line );
         result->offset = pos;
-        result->length = rx.matchedLength();
+        result->length = length;
         result->checkable = checkable;
         result->checkState = checkable ? Qt::Checked : Qt::Unchecked;
         result->capturedTexts = isRE ? rx.capturedTexts() : QStringList();
 
         results << result;
 
-        lastPos = pos;
-        pos += rx.matchedLength();
-
+        pos += length;
+        
+        // big files hand back their results while being searched
         if ( tracker.elapsed() >= mMaxTime )
         {
-            emit const_cast<SearchThread*>( this )->resultsAvailable( fileName, results );
-            results.clear();
+            const_cast<SearchThread*>( this )->flushResults( index, fileName, results );
             tracker.restart();
         }
 
+        if ( isCanceled() )
         {
-            QMutexLocker locker( const_cast<QMutex*>( &mMutex ) );
+            return;
+        }
+    }
+}
 
-            if ( mReset || mExit )
+void SearchThread::flushResults( int index, const QString& fileName, SearchResultsModel::ResultList& results )
+{
+    if ( results.isEmpty() )
+    {
+        return;
+    }
+    
+    if ( index == -1 )
+    {
+        emit resultsAvailable( fileName, results );
+    }
+    else
+    {
+        pushSearchedFile( index, results, false );
+    }
+    
+    results.clear();
+}
+
+bool SearchThread::takeFileToSearch( int& index, QString& fileName )
+{
+    QMutexLocker locker( &mPipelineMutex );
+    
+    if ( mNextFileToSearch >= mFilesToSearch.count() || isCanceled() )
+    {
+        return false;
+    }
+    
+    index = mNextFileToSearch++;
+    fileName = mFilesToSearch.at( index );
+    return true;
+}
+
+void SearchThread::pushSearchedFile( int index, const SearchResultsModel::ResultList& results, bool finished )
+{
+    QMutexLocker locker( &mPipelineMutex );
+    SearchedFile& file = mSearchedFiles[ index ];
+    file.results << results;
+    file.finished = finished;
+    mFileSearched.wakeAll();
+}
+
+bool SearchThread::searchFiles( const QStringList& files, int workers )
+{
+    const int total = files.count();
+    int value = 0;
+    
+    emit progressChanged( 0, total );
+    
+    if ( workers <= 1 )
+    {
+        foreach ( const QString& fileName, files )
+        {
+            SearchResultsModel::ResultList results;
+            search( -1, fileName, fileContent( fileName ), results );
+            
+            if ( isCanceled() )
             {
-                return;
+                qDeleteAll( results );
+                return false;
+            }
+            
+            if ( !results.isEmpty() )
+            {
+                emit resultsAvailable( fileName, results );
             }
+            
+            value++;
+            emit progressChanged( value, total );
         }
+        
+        return true;
     }
-
-    if ( !results.isEmpty() )
+    
+    {
+        QMutexLocker locker( &mPipelineMutex );
+        mFilesToSearch = files;
+        mNextFileToSearch = 0;
+    }
+    
+    QList<SearchWorker*> pool;
+    
+    for ( int i = 0; i < workers; i++ )
+    {
+        SearchWorker* worker = new SearchWorker( this );
+        pool << worker;
+        worker->start();
+    }
+    
+    // workers finish files in any order, results are emitted in the files order
+    while ( value < total )
+    {
+        SearchResultsModel::ResultList results;
+        bool finished = false;
+        
+        {
+            QMutexLocker locker( &mPipelineMutex );
+            QMap<int, SearchedFile>::iterator it = mSearchedFiles.find( value );
+            
+            // mReset / mExit changes are not signaled, poll them while waiting
+            while ( ( it == mSearchedFiles.end() || ( it->results.isEmpty() && !it->finished ) ) && !isCanceled() )
+            {
+                mFileSearched.wait( &mPipelineMutex, mMaxTime );
+                it = mSearchedFiles.find( value );
+            }
+            
+            if ( isCanceled() )
+            {
+                break;
+            }
+            
+            // the partial results of a file still searched are emitted as they come
+            results = it->results;
+            finished = it->finished;
+            
+            if ( finished )
+            {
+                mSearchedFiles.erase( it );
+            }
+            else
+            {
+                it->results.clear();
+            }
+        }
+        
+        if ( !results.isEmpty() )
+        {
+            emit resultsAvailable( files.at( value ), results );
+        }
+        
+        if ( finished )
+        {
+            value++;
+            emit progressChanged( value, total );
+        }
+    }
+    
+    foreach ( SearchWorker* worker, pool )
     {
-        emit const_cast<SearchThread*>( this )->resultsAvailable( fileName, results );
+        worker->wait();
+        delete worker;
     }
+    
+    {
+        QMutexLocker locker( &mPipelineMutex );
+        
+        // results of canceled searches
+        foreach ( const SearchedFile& file, mSearchedFiles )
+        {
+            qDeleteAll( file.results );
+        }
+        
+        mSearchedFiles.clear();
+        mFilesToSearch.clear();
+        mNextFileToSearch = 0;
+    }
+    
+    return value == total;
 }
 
 void SearchThread::run()
@@ -328,6 +573,7 @@ void SearchThread::run()
 
         QStringList files = getFilesToScan();
         files.sort();
+        int workers = 0;
 
         {
             QMutexLocker locker( &mMutex );
@@ -340,39 +586,25 @@ void SearchThread::run()
             {
                 continue;
             }
+            
+            workers = mProperties.settings.searchWorkers;
         }
         
-        const int total = files.count();
-        int value = 0;
-        
-        emit progressChanged( 0, total );
-
-        foreach ( const QString& fileName, files )
+        if ( workers <= 0 )
         {
-            const QString content = fileContent( fileName );
-            search( fileName, content );
-            value++;
-            
-            emit progressChanged( value, total );
-
-            {
-                QMutexLocker locker( &mMutex );
-
-                if ( mExit )
-                {
-                    return;
-                }
-                else if ( mReset )
-                {
-                    break;
-                }
-            }
+            workers = QThread::idealThreadCount();
         }
+        
+        searchFiles( files, qMin( workers, files.count() ) );
 
         {
             QMutexLocker locker( &mMutex );
 
-            if ( mReset )
+            if ( mExit )
+            {
+                return;
+            }
+            else if ( mReset )
             {
                 continue;
             }
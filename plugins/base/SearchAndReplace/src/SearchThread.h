@@ -21,6 +21,7 @@
 
 #include <QThread>
 #include <QMutex>
+#include <QWaitCondition>
 #include <QDir>
 
 #include "SearchWidget.h"
@@ -29,6 +30,7 @@
 class SearchThread : public QThread
 {
     Q_OBJECT
+    friend class SearchWorker;
     
 public:
     SearchThread( QObject* parent = 0 );
@@ -40,16 +42,38 @@ public:
     SearchAndReplace::Properties* properties() const;
 
 protected:
+    struct SearchedFile
+    {
+        SearchedFile()
+        {
+            finished = false;
+        }
+        
+        SearchResultsModel::ResultList results; // results not emitted yet
+        bool finished; // false while the worker still searches the file
+    };
+    
     static int mMaxTime;
     SearchAndReplace::Properties mProperties;
     QMutex mMutex;
     bool mReset;
     bool mExit;
+    // workers pipeline, locked before mMutex when both are needed
+    QMutex mPipelineMutex;
+    QWaitCondition mFileSearched;
+    QStringList mFilesToSearch;
+    int mNextFileToSearch;
+    QMap<int, SearchedFile> mSearchedFiles; // file index, results
     
+    bool isCanceled() const;
     QStringList getFiles( QDir fromDir, const QStringList& filters, bool recursive ) const;
     QStringList getFilesToScan() const;
     QString fileContent( const QString& fileName ) const;
-    void search( const QString& fileName, const QString& content ) const;
+    void search( int index, const QString& fileName, const QString& content, SearchResultsModel::ResultList& results ) const;
+    void flushResults( int index, const QString& fileName, SearchResultsModel::ResultList& results );
+    bool takeFileToSearch( int& index, QString& fileName );
+    void pushSearchedFile( int index, const SearchResultsModel::ResultList& results, bool finished );
+    bool searchFiles( const QStringList& files, int workers );
     virtual void run();
 
 public slots:
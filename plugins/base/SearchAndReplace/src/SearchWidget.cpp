@@ -200,15 +200,6 @@ void SearchWidget::setResultsDock( SearchResultsDock* dock )
     connect( mReplaceThread, SIGNAL( resultsHandled( const QString&, const SearchResultsModel::ResultList& ) ), mDock->model(), SLOT( thread_resultsHandled( const QString&, const SearchResultsModel::ResultList& ) ) );
 }
 
-bool SearchWidget::isBinary( QFile& file )
-{
-    const qint64 position = file.pos();
-    file.seek( 0 );
-    const bool binary = file.read( 1024 ).contains( '\0' );
-    file.seek( position );
-    return binary;
-}
-
 void SearchWidget::setMode( SearchAndReplace::Mode mode )
 {
     mSearchThread->stop();
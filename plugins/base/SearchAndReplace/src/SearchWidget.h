@@ -57,8 +57,6 @@ public:
     SearchThread* searchThread() const;
 
     void setResultsDock( SearchResultsDock* dock );
-    
-    static bool isBinary( QFile& file );
 
 public slots:
     void setMode( SearchAndReplace::Mode mode );
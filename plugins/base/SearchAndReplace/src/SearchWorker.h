@@ -0,0 +1,44 @@
+/****************************************************************************
+    Copyright (C) 2005 - 2011  Filipe AZEVEDO & The Monkey Studio Team
+    http://monkeystudio.org licensing under the GNU GPL.
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+****************************************************************************/
+#ifndef SEARCHWORKER_H
+#define SEARCHWORKER_H
+
+#include <QThread>
+
+class SearchThread;
+
+/*
+    A searching worker of the SearchThread pool.
+    It takes files to search from the thread, read and search them and hand back the results
+    that the thread emits in the files order.
+*/
+class SearchWorker : public QThread
+{
+    Q_OBJECT
+    
+public:
+    SearchWorker( SearchThread* thread );
+
+protected:
+    SearchThread* mThread;
+    
+    virtual void run();
+};
+
+#endif // SEARCHWORKER_H
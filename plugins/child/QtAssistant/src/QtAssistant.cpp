@@ -54,6 +54,7 @@ void QtAssistant::fillPluginInfos()
     mPluginInfos.Name = PLUGIN_NAME;
     mPluginInfos.Version = "0.5.0";
     mPluginInfos.FirstStartEnabled = true;
+    mPluginInfos.DeferredLoading = true;
     mPluginInfos.HaveSettingsWidget = true;
     mPluginInfos.Pixmap = pIconManager::pixmap( "QtAssistant.png", ":/assistant-icons" );
 }
@@ -29,6 +29,7 @@ void QtDesigner::fillPluginInfos()
     mPluginInfos.Name = PLUGIN_NAME;
     mPluginInfos.Version = "1.0.0";
     mPluginInfos.FirstStartEnabled = true;
+    mPluginInfos.DeferredLoading = true;
     mPluginInfos.Pixmap = pIconManager::pixmap( "designer.png", ":/icons" );
 }
 
@@ -35,6 +35,7 @@ void Irc::fillPluginInfos()
     mPluginInfos.Name = PLUGIN_NAME;
     mPluginInfos.Version = "1.0.0";
     mPluginInfos.FirstStartEnabled = false;
+    mPluginInfos.DeferredLoading = true;
     mPluginInfos.Pixmap = QPixmap( ":/icons/irc.png" );
 }
 
@@ -15,6 +15,7 @@ FORMS   = src/settings/UISettingsQMake.ui \
 HEADERS = src/QMake.h \
     src/QMake2XUP.h \
     src/QMakeProjectItem.h \
+    src/QMakeProjectParser.h \
     src/settings/UISettingsQMake.h \
     src/QtVersionManager.h \
     src/editor/QMakeMainEditor.h \
@@ -27,6 +28,7 @@ HEADERS = src/QMake.h \
 SOURCES = src/QMake.cpp \
     src/QMake2XUP.cpp \
     src/QMakeProjectItem.cpp \
+    src/QMakeProjectParser.cpp \
     src/settings/UISettingsQMake.cpp \
     src/QtVersionManager.cpp \
     src/editor/QMakeMainEditor.cpp \
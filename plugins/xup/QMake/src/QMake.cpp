@@ -19,6 +19,7 @@
 #include "QMake.h"
 #include "QtVersionManager.h"
 #include "QMakeProjectItem.h"
+#include "QMakeProjectParser.h"
 #include "UISettingsQMake.h"
 
 #include <coremanager/MonkeyCore.h>
@@ -250,6 +251,7 @@ bool QMake::install()
     mFilters[ "DEFINES" ].filtered = false; // was true
     
     MonkeyCore::projectTypesIndex()->registerType( PLUGIN_NAME, &QMakeProjectItem::staticMetaObject, mFilters );
+    QMakeProjectParser::initializeInterpreterCommands( true );
     return true;
     
     /*
@@ -455,6 +457,7 @@ bool QMake::install()
 
 bool QMake::uninstall()
 {
+    QMakeProjectParser::initializeInterpreterCommands( false );
     MonkeyCore::projectTypesIndex()->unRegisterType( PLUGIN_NAME );
     mFilters.clear();
     delete mQtVersionManager;
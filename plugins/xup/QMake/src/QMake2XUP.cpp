@@ -51,7 +51,6 @@ private:
     QString s;
 };
 
-const QString GENERATED_XUP_VERSION = "1.1.0";
 
 QString QMake2XUP::convertFromPro( const QString& s, const QString& codec )
 {
@@ -90,7 +89,7 @@ QString QMake2XUP::convertFromPro( const QString& s, const QString& codec )
     QRegExp comments("^\\s*#(.*)");
     QRegExp varLine("^\\s*[^}]?(?![\\w\\d_-\\.]+\\s*(?:[*+-~]?=)\\s*)(.*)[ \\t]*\\\\[ \\t]*(#.*)?");
     
-    file.append( QString( "<!DOCTYPE XUPProject>\n<project name=\"%1\" version=\"%2\" expanded=\"false\">\n" ).arg( QFileInfo( s ).fileName() ).arg( GENERATED_XUP_VERSION ) );
+    file.append( QString( "<!DOCTYPE XUPProject>\n<project name=\"%1\" version=\"%2\" expanded=\"false\">\n" ).arg( QFileInfo( s ).fileName() ).arg( QMake2XUP::GENERATED_XUP_VERSION ) );
     try
     {
         for(int i = 0;i < v.size();i++)
@@ -668,7 +667,7 @@ QString QMake2XUP::convertFromPro( const QString& s, const QString& codec )
     catch(const std::exception & e)
     {
         // re-init the XML output
-        file.append( QString( "<!DOCTYPE XUPProject>\n<project name=\"%1\" version=\"%2\" expanded=\"false\">\n" ).arg( QFileInfo( s ).fileName() ).arg( GENERATED_XUP_VERSION ) );
+        file.append( QString( "<!DOCTYPE XUPProject>\n<project name=\"%1\" version=\"%2\" expanded=\"false\">\n" ).arg( QFileInfo( s ).fileName() ).arg( QMake2XUP::GENERATED_XUP_VERSION ) );
         // empty both stacks
         isNested.clear();
         pile.clear();
@@ -709,6 +708,140 @@ QString QMake2XUP::convertToPro( const QDomDocument& document )
     return contents;
 }
 
+// the elements still having their span are copied from the source lines, the modified ones are regenerated
+QString QMake2XUP::convertToPro( const QDomDocument& document, const QStringList& sourceLines )
+{
+    const QDomElement element = document.firstChildElement( "project" );
+    const QString EOL = pMonkeyStudio::getEol();
+    
+    // projects not read from a file have no source
+    if ( element.isNull() || sourceLines.isEmpty() ) {
+        return convertToPro( document );
+    }
+    
+    QString contents = convertChildrenToPro( element, sourceLines, 0, EOL );
+    
+    // remove last eol
+    if ( contents.endsWith( EOL ) ) {
+        contents.chop( EOL.length() );
+    }
+    
+    return contents;
+}
+
+QString QMake2XUP::convertChildrenToPro( const QDomNode& node, const QStringList& sourceLines, int weight, const QString& EOL )
+{
+    QString data;
+    bool spanned = false; // the previous child was copied from the source
+    int previousEndLine = 0;
+    int previousEndColumn = 0;
+    
+    for ( QDomElement child = node.firstChildElement(); !child.isNull(); child = child.nextSiblingElement() ) {
+        int line;
+        int column;
+        int endLine;
+        int endColumn;
+        
+        if ( nodeSpan( child, sourceLines, line, column, endLine, endColumn ) ) {
+            // the text between two unchanged siblings is kept too, ie: } else {
+            if ( spanned ) {
+                data.append( sourceText( sourceLines, previousEndLine, previousEndColumn, endLine, endColumn, EOL ) );
+            }
+            else if ( sourceLines.at( line ).left( column ).trimmed().isEmpty() ) {
+                data.append( sourceText( sourceLines, line, 0, endLine, endColumn, EOL ) );
+            }
+            else {
+                const bool lineStart = data.isEmpty() || data.endsWith( EOL );
+                data.append( tabbedString( lineStart ? weight : 0, sourceText( sourceLines, line, column, endLine, endColumn, EOL ) ) );
+            }
+            
+            spanned = true;
+            previousEndLine = endLine;
+            previousEndColumn = endColumn;
+            continue;
+        }
+        
+        if ( spanned ) {
+            data.append( EOL );
+            spanned = false;
+        }
+        
+        // only an else block can follow a regenerated block on its line
+        const bool lineStart = data.isEmpty() || data.endsWith( EOL );
+        
+        // a modified block keeps the source of its unchanged children
+        if ( child.nodeName().compare( "scope", Qt::CaseInsensitive ) == 0 && !isNested( child ) && child.hasChildNodes() ) {
+            const QString comment = nodeAttribute( child, "comment" );
+            const QString closingComment = nodeAttribute( child, "closing-comment" );
+            const QDomElement sibling = child.nextSiblingElement();
+            
+            data.append( tabbedString( lineStart ? weight : 0, nodeAttribute( child, "name" ) ).append( " {" ) );
+            
+            if ( !comment.isEmpty() ) {
+                data.append( ' ' +comment );
+            }
+            
+            data.append( EOL );
+            data.append( convertChildrenToPro( child, sourceLines, weight +1, EOL ) );
+            data.append( tabbedString( weight, "}" ) );
+            
+            if ( isBlock( sibling ) && nodeAttribute( sibling, "name" ).compare( "else", Qt::CaseInsensitive ) == 0 ) {
+                data.append( ' ' );
+            }
+            else {
+                if ( !closingComment.isEmpty() ) {
+                    data.append( ' ' +closingComment );
+                }
+                
+                data.append( EOL );
+            }
+        }
+        else {
+            const QString text = convertNodeToPro( child, weight, false, false, EOL );
+            data.append( lineStart ? text : text.mid( weight *4 ) );
+        }
+    }
+    
+    if ( spanned ) {
+        data.append( EOL );
+    }
+    
+    return data;
+}
+
+// the source position of an unchanged node, see QMakeProjectParser
+bool QMake2XUP::nodeSpan( const QDomNode& node, const QStringList& sourceLines, int& line, int& column, int& endLine, int& endColumn )
+{
+    const QStringList parts = nodeAttribute( node, "span" ).split( QRegExp( "[:-]" ) );
+    
+    if ( parts.count() != 4 ) {
+        return false;
+    }
+    
+    line = parts.at( 0 ).toInt() -1;
+    column = parts.at( 1 ).toInt();
+    endLine = parts.at( 2 ).toInt() -1;
+    endColumn = parts.at( 3 ).toInt();
+    
+    return line >= 0 && endLine < sourceLines.count()
+        && ( line < endLine || ( line == endLine && column <= endColumn ) );
+}
+
+QString QMake2XUP::sourceText( const QStringList& sourceLines, int line, int column, int endLine, int endColumn, const QString& EOL )
+{
+    if ( line == endLine ) {
+        return sourceLines.at( line ).mid( column, endColumn -column );
+    }
+    
+    QStringList text;
+    
+    text << sourceLines.at( line ).mid( column );
+    text << sourceLines.mid( line +1, endLine -line -1 );
+    text << sourceLines.at( endLine ).left( endColumn );
+    
+    return text.join( EOL );
+}
+
 QString QMake2XUP::escape( const QString& string )
 {
     return
@@ -25,12 +25,18 @@
 
 namespace QMake2XUP
 {
+    const QString GENERATED_XUP_VERSION = "1.1.0";
+    
     QString convertFromPro( const QString& fileName, const QString& codec );
     QString convertToPro( const QDomDocument& project );
+    QString convertToPro( const QDomDocument& project, const QStringList& sourceLines );
     
     QString escape( const QString& string );
 
     QString convertNodeToPro( const QDomNode& node, int weight = 0, bool multiline = false, bool nested = false, const QString& EOL = pMonkeyStudio::getEol() );
+    QString convertChildrenToPro( const QDomNode& node, const QStringList& sourceLines, int weight, const QString& EOL );
+    bool nodeSpan( const QDomNode& node, const QStringList& sourceLines, int& line, int& column, int& endLine, int& endColumn );
+    QString sourceText( const QStringList& sourceLines, int line, int column, int endLine, int endColumn, const QString& EOL );
     QString tabbedString( int weight, const QString& string, const QString& eol = QString::null );
     QString nodeAttribute( const QDomNode& node, const QString& attribute, const QString& defaultValue = QString::null );
     bool isMultiline( const QDomNode& node );
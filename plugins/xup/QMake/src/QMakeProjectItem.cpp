@@ -20,6 +20,7 @@
 #include "QtVersionManager.h"
 #include "QMake.h"
 #include "QMake2XUP.h"
+#include "QMakeProjectParser.h"
 #include "editor/UIQMakeEditor.h"
 
 #include <xupmanager/core/XUPProjectItemHelper.h>
@@ -120,28 +121,9 @@ QStringList QMakeProjectItemCacheBackend::guessedVariable( XUPProjectItem* proje
     }
     // qmake variable
     else if ( variable.startsWith( "$$[" ) ) {
-        // caching result for now, we may disable if needed as user can change qmake variable outside
-        if ( cachedData.value( project ).contains( name ) ) {
-            return cachedData[ project ][ name ];
-        }
-        
+        // properties are queried once per qmake binary and shared by all projects
         const QtVersion version = QMake::versionManager()->version( XUPProjectItemHelper::projectSettingsValue( project, "QT_VERSION" ) );
-        QString output;
-        
-        if ( version.isValid() ) {
-            QProcess query;
-            query.start( QString( "%1 -query %2" ).arg( version.qmake() ).arg( name ) );
-            query.waitForFinished();
-            output = QString::fromLocal8Bit( query.readAll() ).trimmed();
-            
-            if ( output == "**Unknown**" ) {
-                output.clear();
-            }
-        }
-        
-        // caching result for now, we may disable if needed as user can change qmake variable outside
-        cachedData[ project ][ name ] = QStringList( output );
-        return QStringList( output );
+        return QStringList( QMake::versionManager()->queryProperty( version, name ) );
     }
     // project variable
     else {
@@ -420,7 +402,7 @@ QString QMakeProjectItem::defaultOperator() const
 
 QString QMakeProjectItem::toNativeString() const
 {
-    return QMake2XUP::convertToPro( mDocument );
+    return QMake2XUP::convertToPro( mDocument, mSourceLines );
 }
 
 QString QMakeProjectItem::projectType() const
@@ -430,23 +412,20 @@ QString QMakeProjectItem::projectType() const
 
 bool QMakeProjectItem::open( const QString& fileName, const QString& codec )
 {
-    QString buffer = QMake2XUP::convertFromPro( fileName, codec );
-    
-    // parse content
-    QString errorMsg;
-    int errorLine;
-    int errorColumn;
+    QMakeProjectParser parser( documentFilters() );
     
-    if ( !mDocument.setContent( buffer, &errorMsg, &errorLine, &errorColumn ) ) {
-        showError( tr( "Xml error in '%1':\n%2 on line %3, column %4" )
-            .arg( fileName )
-            .arg( errorMsg )
-            .arg( errorLine )
-            .arg( errorColumn )
-        );
+    // build the document directly from the qmake file
+    if ( !parser.parse( fileName, codec, mDocument ) ) {
+        showError( parser.errorString() );
         return false;
     }
     
+    mSourceLines = parser.lines();
+    
+    foreach ( const QString& warning, parser.warnings() ) {
+        qWarning( "%s", warning.toLocal8Bit().constData() );
+    }
+    
     // check project validity
     mDomElement = mDocument.firstChildElement( "project" );
     
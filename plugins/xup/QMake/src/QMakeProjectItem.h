@@ -113,6 +113,7 @@ public:
 protected:
     static QMakeProjectItemCacheBackend mCacheBackend;
     pCommand mLastCommand;
+    QStringList mSourceLines; // the opened file, the unchanged elements are written back from it
     
     virtual UIXUPEditor* newEditDialog() const;
     
@@ -0,0 +1,797 @@
+/****************************************************************************
+    Copyright (C) 2005 - 2011  Filipe AZEVEDO & The Monkey Studio Team
+    http://monkeystudio.org licensing under the GNU GPL.
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+****************************************************************************/
+#include "QMakeProjectParser.h"
+#include "QMake2XUP.h"
+
+#include <coremanager/MonkeyCore.h>
+#include <shellmanager/MkSShellInterpreter.h>
+#include <pMonkeyStudio.h>
+
+#include <QCoreApplication>
+#include <QDirIterator>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QTextCodec>
+
+QMakeProjectParser::QMakeProjectParser( const DocumentFilterMap& filters )
+{
+    mFileVariables = filters.fileVariables().toSet();
+    mPathVariables = filters.pathVariables().toSet();
+    mLine = -1;
+    mColumn = 0;
+    mEndColumn = -1;
+}
+
+bool QMakeProjectParser::parse( const QString& fileName, const QString& codec, QDomDocument& document )
+{
+    QFile file( fileName );
+    
+    mErrorString.clear();
+    mWarnings.clear();
+    mFileName = fileName;
+    
+    if ( !file.open( QIODevice::ReadOnly | QIODevice::Text ) ) {
+        mErrorString = QCoreApplication::translate( "QMakeProjectParser", "Can't open '%1' for reading" ).arg( fileName );
+        return false;
+    }
+    
+    QTextCodec* textCodec = QTextCodec::codecForName( codec.toUtf8() );
+    
+    if ( !textCodec ) {
+        textCodec = QTextCodec::codecForLocale();
+    }
+    
+    mLines = textCodec->toUnicode( file.readAll() ).split( '\n' );
+    mDocument = QDomDocument( "XUPProject" );
+    mFrames.clear();
+    
+    QDomElement project = mDocument.createElement( "project" );
+    project.setAttribute( "name", QFileInfo( fileName ).fileName() );
+    project.setAttribute( "version", QMake2XUP::GENERATED_XUP_VERSION );
+    project.setAttribute( "expanded", "false" );
+    mDocument.appendChild( project );
+    mFrames << Frame( project );
+    
+    int emptyLines = 0;
+    
+    for ( mLine = 0; mLine < mLines.count(); mLine++ ) {
+        const QString line = mLines.at( mLine ).trimmed();
+        
+        if ( line.isEmpty() ) {
+            emptyLines++;
+            
+            // consecutive empty lines are merged in one node
+            if ( mLine +1 == mLines.count() || !mLines.at( mLine +1 ).trimmed().isEmpty() ) {
+                QDomElement element = appendElement( mFrames.last().element, "emptyline" );
+                element.setAttribute( "count", emptyLines );
+                setSpan( element, mLine -emptyLines +1, 0, mLine, mLines.at( mLine ).length() );
+                emptyLines = 0;
+            }
+            
+            continue;
+        }
+        
+        mColumn = indentation( mLines.at( mLine ) );
+        
+        if ( !parseStatement( line ) ) {
+            appendUnknownStatement( line );
+        }
+    }
+    
+    // blocks left opened end with the file
+    while ( mFrames.count() > 1 ) {
+        const Frame frame = mFrames.takeLast();
+        setSpan( frame.element, frame.line, frame.column, mLines.count() -1, lineEnd( mLines.last() ) );
+    }
+    
+    document = mDocument;
+    mDocument = QDomDocument();
+    mFrames.clear();
+    mLine = -1;
+    mColumn = 0;
+    mEndColumn = -1;
+    
+    return true;
+}
+
+QString QMakeProjectParser::errorString() const
+{
+    return mErrorString;
+}
+
+QStringList QMakeProjectParser::warnings() const
+{
+    return mWarnings;
+}
+
+// the lines of the last parsed file, the spans refer to them
+QStringList QMakeProjectParser::lines() const
+{
+    return mLines;
+}
+
+QDomElement QMakeProjectParser::appendElement( QDomElement parent, const QString& tagName )
+{
+    QDomElement element = mDocument.createElement( tagName );
+    parent.appendChild( element );
+    return element;
+}
+
+// keep a line the parser does not understand as a comment so it is written back unchanged
+void QMakeProjectParser::appendUnknownStatement( const QString& line )
+{
+    QDomElement element = appendElement( mFrames.last().element, "comment" );
+    element.setAttribute( "value", line );
+    setSpan( element, mLine, mColumn, mLine, statementEnd() );
+    mWarnings << QCoreApplication::translate( "QMakeProjectParser", "Unknown statement in '%1' at line %2: %3" ).arg( mFileName ).arg( mLine +1 ).arg( line );
+}
+
+QDomElement QMakeProjectParser::appendScopes( QDomElement parent, const QStringList& scopes )
+{
+    foreach ( const QString& scope, scopes ) {
+        parent = appendElement( parent, "scope" );
+        parent.setAttribute( "name", scope );
+        parent.setAttribute( "nested", "true" );
+    }
+    
+    return parent;
+}
+
+// open a block, the scopes before the last one are nested, ie: win32:debug {
+QDomElement QMakeProjectParser::appendBlock( QStringList scopes, const QString& comment )
+{
+    const QString name = scopes.takeLast();
+    QDomElement parent = mFrames.last().element;
+    
+    foreach ( const QString& scope, scopes ) {
+        parent = appendScopes( parent, QStringList( scope ) );
+        mFrames << Frame( parent, true, mLine, mColumn );
+    }
+    
+    QDomElement block = appendElement( parent, "scope" );
+    block.setAttribute( "name", name );
+    
+    if ( !comment.isEmpty() ) {
+        block.setAttribute( "comment", comment );
+    }
+    
+    mFrames << Frame( block, false, mLine, mColumn );
+    return block;
+}
+
+// close the current block at the '}' of column, the statement following it is parsed
+void QMakeProjectParser::closeBlock( const QString& statement, int column )
+{
+    const int endColumn = statement.startsWith( '#' ) ? lineEnd( mLines.at( mLine ) ) : column +1;
+    Frame frame = mFrames.takeLast();
+    
+    setSpan( frame.element, frame.line, frame.column, mLine, endColumn );
+    
+    while ( mFrames.last().prefix ) {
+        const Frame prefix = mFrames.takeLast();
+        setSpan( prefix.element, prefix.line, prefix.column, mLine, endColumn );
+    }
+    
+    if ( statement.startsWith( '#' ) ) {
+        frame.element.setAttribute( "closing-comment", statement );
+        return;
+    }
+    
+    if ( !statement.isEmpty() ) {
+        mColumn = mLines.at( mLine ).indexOf( statement, column +1 );
+        
+        if ( !parseStatement( statement ) ) {
+            appendUnknownStatement( statement );
+        }
+    }
+}
+
+void QMakeProjectParser::setSpan( QDomElement element, int line, int column, int endLine, int endColumn )
+{
+    element.setAttribute( "span", QString( "%1:%2-%3:%4" ).arg( line +1 ).arg( column ).arg( endLine +1 ).arg( endColumn ) );
+}
+
+// set the span of element and of the nested scopes up to the current frame
+void QMakeProjectParser::setStatementSpan( QDomElement element, int line, int column )
+{
+    const QDomElement frame = mFrames.last().element;
+    
+    for ( ; !element.isNull() && element != frame; element = element.parentNode().toElement() ) {
+        setSpan( element, line, column, mLine, statementEnd() );
+    }
+}
+
+int QMakeProjectParser::statementEnd() const
+{
+    return mEndColumn == -1 ? lineEnd( mLines.at( mLine ) ) : mEndColumn;
+}
+
+bool QMakeProjectParser::parseStatement( const QString& line )
+{
+    // comment
+    if ( line.startsWith( '#' ) ) {
+        QDomElement element = appendElement( mFrames.last().element, "comment" );
+        element.setAttribute( "value", line );
+        setSpan( element, mLine, mColumn, mLine, lineEnd( mLines.at( mLine ) ) );
+        return true;
+    }
+    
+    // end of block, it can be followed by a statement, ie: } else {
+    if ( line.startsWith( '}' ) ) {
+        if ( mFrames.count() < 2 || mFrames.last().prefix ) {
+            return false;
+        }
+        
+        closeBlock( line.mid( 1 ).trimmed(), mColumn );
+        return true;
+    }
+    
+    QString code;
+    QString comment;
+    int length = 0;
+    
+    splitComment( line, code, comment );
+    
+    // variable, ie: win32:SOURCES += main.cpp
+    const int op = findOperator( code, length );
+    
+    if ( op != -1 ) {
+        QStringList scopes = splitScopes( code.left( op ) );
+        const QString name = scopes.isEmpty() ? QString::null : scopes.takeLast();
+        
+        if ( isVariableName( name ) ) {
+            const QString value = code.mid( op +length ).trimmed();
+            const int valueColumn = value.isEmpty() ? mColumn +op +length : mLines.at( mLine ).indexOf( value, mColumn +op +length );
+            parseVariable( scopes, name, code.mid( op, length ), value, comment, valueColumn );
+            return true;
+        }
+    }
+    
+    // one line block, ie: win32 { LIBS += -lfoo } else { LIBS += -lbar }
+    int close = -1;
+    const int open = findBlock( code, close );
+    
+    if ( open > 0 && close != -1 ) {
+        const QStringList scopes = blockScopes( code.left( open ) );
+        
+        if ( !scopes.isEmpty() ) {
+            // code starts the statement, its indexes are the ones of line
+            const int column = mColumn;
+            const QString body = code.mid( open +1, close -open -1 ).trimmed();
+            
+            appendBlock( scopes, QString::null );
+            
+            // the statement of the block ends before its '}'
+            if ( !body.isEmpty() ) {
+                const int endColumn = mEndColumn;
+                
+                mColumn = mLines.at( mLine ).indexOf( body, column +open +1 );
+                mEndColumn = mColumn +body.length();
+                
+                if ( !parseStatement( body ) ) {
+                    appendUnknownStatement( body );
+                }
+                
+                mEndColumn = endColumn;
+            }
+            
+            closeBlock( line.mid( close +1 ).trimmed(), column +close );
+            return true;
+        }
+    }
+    
+    // block, ie: win32:debug {
+    if ( code.endsWith( '{' ) ) {
+        const QStringList scopes = blockScopes( code.left( code.length() -1 ) );
+        
+        if ( !scopes.isEmpty() ) {
+            appendBlock( scopes, comment );
+            return true;
+        }
+    }
+    
+    // function call, ie: unix:include( unix.pri )
+    QStringList scopes = splitScopes( code );
+    const QString call = scopes.isEmpty() ? QString::null : scopes.takeLast();
+    
+    if ( isFunctionCall( call ) ) {
+        const int open = call.indexOf( '(' );
+        QDomElement function = appendElement( appendScopes( mFrames.last().element, scopes ), "function" );
+        
+        if ( !comment.isEmpty() ) {
+            function.setAttribute( "comment", comment );
+        }
+        
+        function.setAttribute( "name", call.left( open ).trimmed() );
+        function.setAttribute( "parameters", call.mid( open +1, call.length() -open -2 ).trimmed() );
+        setStatementSpan( function, mLine, mColumn );
+        return true;
+    }
+    
+    return false;
+}
+
+void QMakeProjectParser::parseVariable( const QStringList& scopes, const QString& name, const QString& op, QString value, const QString& comment, int valueColumn )
+{
+    const int line = mLine;
+    QDomElement variable = appendElement( appendScopes( mFrames.last().element, scopes ), "variable" );
+    variable.setAttribute( "name", name );
+    
+    if ( op != "=" ) {
+        variable.setAttribute( "operator", op );
+    }
+    
+    bool continued = value.endsWith( '\\' );
+    
+    // a lone backslash followed by an empty line or a statement is a value, comments don't end a continuation
+    if ( value == "\\" ) {
+        const QString next = mLine +1 < mLines.count() ? mLines.at( mLine +1 ).trimmed() : QString::null;
+        continued = !next.isEmpty() && ( next.startsWith( '#' ) || !isStatement( next ) );
+    }
+    
+    if ( continued ) {
+        value.chop( 1 );
+        value = value.trimmed();
+    }
+    
+    appendValues( variable, name, value, comment, valueColumn );
+    
+    // multi lines variable
+    while ( continued && mLine +1 < mLines.count() ) {
+        const QString text = mLines.at( ++mLine ).trimmed();
+        const int column = indentation( mLines.at( mLine ) );
+        QString code;
+        QString lineComment;
+        
+        // like qmake, a comment line inside a continuation is skipped and the continuation goes on
+        if ( text.startsWith( '#' ) ) {
+            QDomElement element = appendElement( variable, "comment" );
+            element.setAttribute( "value", text );
+            setSpan( element, mLine, column, mLine, lineEnd( mLines.at( mLine ) ) );
+            continue;
+        }
+        
+        splitComment( text, code, lineComment );
+        continued = code.endsWith( '\\' );
+        
+        if ( continued ) {
+            code.chop( 1 );
+            code = code.trimmed();
+        }
+        
+        appendValues( variable, name, code, lineComment, column );
+    }
+    
+    setStatementSpan( variable, line, mColumn );
+}
+
+void QMakeProjectParser::appendValues( QDomElement variable, const QString& name, const QString& value, const QString& comment, int column )
+{
+    const bool isFile = mFileVariables.contains( name );
+    const bool isPath = !isFile && mPathVariables.contains( name );
+    
+    if ( !isFile && !isPath ) {
+        QDomElement element = appendElement( variable, "value" );
+        
+        if ( !comment.isEmpty() ) {
+            element.setAttribute( "comment", comment );
+        }
+        
+        if ( !value.isEmpty() ) {
+            element.appendChild( mDocument.createTextNode( value ) );
+        }
+        
+        setSpan( element, mLine, column, mLine, column +value.length() );
+        return;
+    }
+    
+    // files and paths have a node per value, quoted values can contain spaces
+    QStringList values;
+    QString quoted;
+    bool inString = false;
+    
+    foreach ( const QString& part, value.split( ' ' ) ) {
+        if ( part.startsWith( '"' ) ) {
+            inString = true;
+        }
+        
+        if ( inString ) {
+            if ( !quoted.isEmpty() ) {
+                quoted.append( ' ' );
+            }
+            
+            quoted.append( part );
+            
+            if ( part.endsWith( '"' ) ) {
+                values << quoted;
+                quoted.clear();
+                inString = false;
+            }
+        }
+        else {
+            values << part;
+        }
+    }
+    
+    if ( !quoted.isEmpty() ) {
+        values << quoted;
+    }
+    
+    const QString& line = mLines.at( mLine );
+    
+    for ( int i = 0; i < values.count(); i++ ) {
+        QDomElement element = appendElement( variable, isFile ? "file" : "path" );
+        
+        if ( !comment.isEmpty() && i == values.count() -1 ) {
+            element.setAttribute( "comment", comment );
+        }
+        
+        if ( !values.at( i ).isEmpty() ) {
+            element.appendChild( mDocument.createTextNode( values.at( i ) ) );
+            column = qMax( column, line.indexOf( values.at( i ), column ) );
+        }
+        
+        setSpan( element, mLine, column, mLine, column +values.at( i ).length() );
+        column += values.at( i ).length();
+    }
+}
+
+bool QMakeProjectParser::isStatement( const QString& line ) const
+{
+    if ( line.startsWith( '#' ) || line.startsWith( '}' ) ) {
+        return true;
+    }
+    
+    QString code;
+    QString comment;
+    int length = 0;
+    
+    splitComment( line, code, comment );
+    
+    const int op = findOperator( code, length );
+    
+    if ( op != -1 ) {
+        const QStringList scopes = splitScopes( code.left( op ) );
+        
+        if ( !scopes.isEmpty() && isVariableName( scopes.last() ) ) {
+            return true;
+        }
+    }
+    
+    int close = -1;
+    
+    if ( code.endsWith( '{' ) || ( findBlock( code, close ) > 0 && close != -1 ) ) {
+        return true;
+    }
+    
+    const QStringList scopes = splitScopes( code );
+    return !scopes.isEmpty() && isFunctionCall( scopes.last() );
+}
+
+void QMakeProjectParser::splitComment( const QString& line, QString& code, QString& comment )
+{
+    const int index = line.indexOf( '#' );
+    
+    if ( index == -1 ) {
+        code = line.trimmed();
+        comment.clear();
+    }
+    else {
+        code = line.left( index ).trimmed();
+        comment = line.mid( index ).trimmed();
+    }
+}
+
+// split on ':' outside of parentheses, ie: contains( A, b:c ):win32
+QStringList QMakeProjectParser::splitScopes( const QString& string )
+{
+    QStringList scopes;
+    int depth = 0;
+    int start = 0;
+    
+    for ( int i = 0; i <= string.length(); i++ ) {
+        const QChar c = i < string.length() ? string.at( i ) : QChar( ':' );
+        
+        if ( c == '(' ) {
+            depth++;
+        }
+        else if ( c == ')' ) {
+            depth--;
+        }
+        else if ( c == ':' && depth <= 0 ) {
+            const QString scope = string.mid( start, i -start ).trimmed();
+            
+            if ( !scope.isEmpty() ) {
+                scopes << scope;
+            }
+            
+            start = i +1;
+        }
+    }
+    
+    return scopes;
+}
+
+// the scopes of a block head, ie: win32:debug: of win32:debug: {
+QStringList QMakeProjectParser::blockScopes( QString head )
+{
+    head = head.trimmed();
+    
+    while ( head.endsWith( ':' ) ) {
+        head.chop( 1 );
+        head = head.trimmed();
+    }
+    
+    return splitScopes( head );
+}
+
+// the position of the first assignment operator outside of parentheses
+int QMakeProjectParser::findOperator( const QString& string, int& length )
+{
+    int depth = 0;
+    
+    for ( int i = 0; i < string.length(); i++ ) {
+        const QChar c = string.at( i );
+        
+        if ( c == '(' ) {
+            depth++;
+        }
+        else if ( c == ')' ) {
+            depth--;
+        }
+        else if ( c == '=' && depth <= 0 ) {
+            if ( i > 0 && QString( "+-*~" ).contains( string.at( i -1 ) ) ) {
+                length = 2;
+                return i -1;
+            }
+            
+            length = 1;
+            return i;
+        }
+    }
+    
+    return -1;
+}
+
+// the position of the first '{' outside of parentheses, close is its matching '}' or -1
+int QMakeProjectParser::findBlock( const QString& string, int& close )
+{
+    int depth = 0;
+    int braces = 0;
+    int open = -1;
+    
+    close = -1;
+    
+    for ( int i = 0; i < string.length(); i++ ) {
+        const QChar c = string.at( i );
+        
+        if ( open == -1 ) {
+            if ( c == '(' ) {
+                depth++;
+            }
+            else if ( c == ')' ) {
+                depth--;
+            }
+            else if ( c == '{' && depth <= 0 ) {
+                open = i;
+                braces = 1;
+            }
+        }
+        else if ( c == '{' ) {
+            braces++;
+        }
+        else if ( c == '}' && --braces == 0 ) {
+            close = i;
+            break;
+        }
+    }
+    
+    return open;
+}
+
+bool QMakeProjectParser::isVariableName( const QString& string )
+{
+    if ( string.isEmpty() ) {
+        return false;
+    }
+    
+    foreach ( const QChar& c, string ) {
+        if ( !c.isLetterOrNumber() && c != '.' && c != '_' && c != '*' && c != '!' ) {
+            return false;
+        }
+    }
+    
+    return true;
+}
+
+bool QMakeProjectParser::isFunctionCall( const QString& string )
+{
+    const int open = string.indexOf( '(' );
+    
+    if ( open <= 0 || !string.endsWith( ')' ) ) {
+        return false;
+    }
+    
+    const QString name = string.left( open ).trimmed();
+    return !name.isEmpty() && !name.contains( ' ' ) && !name.contains( '\t' );
+}
+
+int QMakeProjectParser::indentation( const QString& line )
+{
+    int column = 0;
+    
+    while ( column < line.length() && line.at( column ).isSpace() ) {
+        column++;
+    }
+    
+    return column;
+}
+
+int QMakeProjectParser::lineEnd( const QString& line )
+{
+    int column = line.length();
+    
+    while ( column > 0 && line.at( column -1 ).isSpace() ) {
+        column--;
+    }
+    
+    return column;
+}
+
+void QMakeProjectParser::removeSpans( QDomElement element )
+{
+    element.removeAttribute( "span" );
+    
+    for ( QDomElement child = element.firstChildElement(); !child.isNull(); child = child.nextSiblingElement() ) {
+        removeSpans( child );
+    }
+}
+
+void QMakeProjectParser::initializeInterpreterCommands( bool initialize )
+{
+    if ( initialize ) {
+        const QString help = MkSShellInterpreter::tr(
+            "This command benchmarks the qmake project parser against the legacy XML conversion, usage:\n"
+            "\tqmakeparser benchmark <file or directory> [...]"
+        );
+        
+        MonkeyCore::interpreter()->addCommandImplementation( "qmakeparser", QMakeProjectParser::commandInterpreter, help, 0 );
+    }
+    else {
+        MonkeyCore::interpreter()->removeCommandImplementation( "qmakeparser" );
+    }
+}
+
+QString QMakeProjectParser::commandInterpreter( const QString& command, const QStringList& _arguments, int* result, MkSShellInterpreter* interpreter, void* data )
+{
+    Q_UNUSED( command );
+    Q_UNUSED( data );
+    QStringList arguments = _arguments;
+    
+    if ( arguments.count() < 2 || arguments.first() != "benchmark" ) {
+        if ( result ) {
+            *result = MkSShellInterpreter::InvalidCommand;
+        }
+        
+        return interpreter->usage( "qmakeparser" );
+    }
+    
+    arguments.removeFirst();
+    
+    // the projects to parse
+    QStringList fileNames;
+    
+    foreach ( const QString& argument, arguments ) {
+        const QFileInfo info( argument );
+        
+        if ( info.isDir() ) {
+            QDirIterator it( info.absoluteFilePath(), QStringList() << "*.pro" << "*.pri", QDir::Files, QDirIterator::Subdirectories );
+            
+            while ( it.hasNext() ) {
+                fileNames << it.next();
+            }
+        }
+        else if ( info.isFile() ) {
+            fileNames << info.absoluteFilePath();
+        }
+    }
+    
+    const DocumentFilterMap& filters = MonkeyCore::projectTypesIndex()->documentFilters( PLUGIN_NAME );
+    const QString codec = pMonkeyStudio::defaultCodec();
+    const int passes = 10;
+    QStringList differences;
+    QStringList errors;
+    QStringList warnings;
+    QElapsedTimer timer;
+    
+    // compare the trees
+    foreach ( const QString& fileName, fileNames ) {
+        QDomDocument legacy;
+        QDomDocument document;
+        QMakeProjectParser parser( filters );
+        
+        legacy.setContent( QMake2XUP::convertFromPro( fileName, codec ) );
+        
+        if ( !parser.parse( fileName, codec, document ) ) {
+            errors << parser.errorString();
+            continue;
+        }
+        
+        warnings << parser.warnings();
+        
+        // the legacy conversion has no source positions
+        removeSpans( document.documentElement() );
+        
+        if ( legacy.toString( 4 ) != document.toString( 4 ) ) {
+            differences << fileName;
+        }
+    }
+    
+    timer.start();
+    
+    for ( int i = 0; i < passes; i++ ) {
+        foreach ( const QString& fileName, fileNames ) {
+            QDomDocument document;
+            document.setContent( QMake2XUP::convertFromPro( fileName, codec ) );
+        }
+    }
+    
+    const qint64 legacyElapsed = timer.restart();
+    
+    for ( int i = 0; i < passes; i++ ) {
+        foreach ( const QString& fileName, fileNames ) {
+            QDomDocument document;
+            QMakeProjectParser parser( filters );
+            parser.parse( fileName, codec, document );
+        }
+    }
+    
+    const qint64 parserElapsed = timer.elapsed();
+    QStringList output;
+    
+    output << MkSShellInterpreter::tr( "%1 project(s), %2 pass(es)" ).arg( fileNames.count() ).arg( passes );
+    output << MkSShellInterpreter::tr( "QMake2XUP and QDomDocument::setContent(): %1 ms" ).arg( legacyElapsed );
+    output << MkSShellInterpreter::tr( "QMakeProjectParser: %1 ms" ).arg( parserElapsed );
+    
+    if ( parserElapsed > 0 ) {
+        output << MkSShellInterpreter::tr( "Speedup: %1x" ).arg( double( legacyElapsed ) /parserElapsed, 0, 'f', 1 );
+    }
+    
+    if ( !differences.isEmpty() ) {
+        output << MkSShellInterpreter::tr( "Trees different from the legacy conversion:" );
+        output << differences;
+    }
+    
+    if ( !warnings.isEmpty() ) {
+        output << MkSShellInterpreter::tr( "Unknown statements:" );
+        output << warnings;
+    }
+    
+    if ( !errors.isEmpty() ) {
+        output << MkSShellInterpreter::tr( "Errors:" );
+        output << errors;
+    }
+    
+    if ( result ) {
+        *result = MkSShellInterpreter::NoError;
+    }
+    
+    return output.join( "\n" );
+}
@@ -0,0 +1,103 @@
+/****************************************************************************
+    Copyright (C) 2005 - 2011  Filipe AZEVEDO & The Monkey Studio Team
+    http://monkeystudio.org licensing under the GNU GPL.
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+****************************************************************************/
+#ifndef QMAKEPROJECTPARSER_H
+#define QMAKEPROJECTPARSER_H
+
+#include <xupmanager/core/ProjectTypesIndex.h>
+
+#include <QDomDocument>
+#include <QStringList>
+#include <QSet>
+
+class MkSShellInterpreter;
+
+/*
+    A single pass qmake parser building the XUP document of a .pro/.pri file in place,
+    without generating and re-parsing an intermediate XML buffer.
+    Each generated element has a span attribute giving its source position as
+    "line:column-endLine:endColumn", lines start at 1, columns at 0 and the end is exclusive.
+    XUPItem drops the span of an element, and of its parents, once it is modified.
+    QMake2XUP::convertToPro() writes the elements still having a span back from lines(),
+    only the modified ones are regenerated.
+*/
+class QMakeProjectParser
+{
+public:
+    QMakeProjectParser( const DocumentFilterMap& filters );
+    
+    bool parse( const QString& fileName, const QString& codec, QDomDocument& document );
+    QString errorString() const;
+    QStringList warnings() const;
+    QStringList lines() const;
+    
+    static void initializeInterpreterCommands( bool initialize );
+    static QString commandInterpreter( const QString& command, const QStringList& arguments, int* result, MkSShellInterpreter* interpreter, void* data );
+
+protected:
+    // an opened block, prefix are the nested scopes of the block line, ie: win32:debug {
+    struct Frame
+    {
+        Frame( const QDomElement& _element = QDomElement(), bool _prefix = false, int _line = 0, int _column = 0 )
+            : element( _element ), prefix( _prefix ), line( _line ), column( _column )
+        {}
+        
+        QDomElement element;
+        bool prefix;
+        int line;
+        int column;
+    };
+    
+    QSet<QString> mFileVariables;
+    QSet<QString> mPathVariables;
+    QString mFileName;
+    QDomDocument mDocument;
+    QStringList mLines;
+    int mLine;
+    int mColumn; // the column of the statement being parsed in the current line
+    int mEndColumn; // the end of the statement being parsed, -1 for the end of its line
+    QList<Frame> mFrames;
+    QString mErrorString;
+    QStringList mWarnings;
+    
+    QDomElement appendElement( QDomElement parent, const QString& tagName );
+    QDomElement appendScopes( QDomElement parent, const QStringList& scopes );
+    QDomElement appendBlock( QStringList scopes, const QString& comment );
+    void closeBlock( const QString& statement, int column );
+    void appendUnknownStatement( const QString& line );
+    void setSpan( QDomElement element, int line, int column, int endLine, int endColumn );
+    void setStatementSpan( QDomElement element, int line, int column );
+    int statementEnd() const;
+    bool parseStatement( const QString& line );
+    void parseVariable( const QStringList& scopes, const QString& name, const QString& op, QString value, const QString& comment, int valueColumn );
+    void appendValues( QDomElement variable, const QString& name, const QString& value, const QString& comment, int column );
+    bool isStatement( const QString& line ) const;
+    
+    static void splitComment( const QString& line, QString& code, QString& comment );
+    static QStringList splitScopes( const QString& string );
+    static QStringList blockScopes( QString head );
+    static int findOperator( const QString& string, int& length );
+    static int findBlock( const QString& string, int& close );
+    static bool isVariableName( const QString& string );
+    static bool isFunctionCall( const QString& string );
+    static int indentation( const QString& line );
+    static int lineEnd( const QString& line );
+    static void removeSpans( QDomElement element );
+};
+
+#endif // QMAKEPROJECTPARSER_H
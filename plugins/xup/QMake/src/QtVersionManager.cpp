@@ -33,6 +33,7 @@ const QString QtVersionManager::mQtConfigurationKey = "Configurations";
 const QRegExp QtVersionManager::mQtVersionRegExp( "\\d\\.\\d\\.\\d[\\d\\w-_]*" );
 const QRegExp QtVersionManager::mQtQMakeRegExp( QString( "QMake version (?:[\\d\\w-_\\.]+)(?:\\r|\\n|\\r\\n)Using Qt version (%1) in (.*)" ).arg( QtVersionManager::mQtVersionRegExp.pattern() ) );
 const QRegExp QtVersionManager::mQtUninstallRegExp( "Qt (?:OpenSource|SDK|Commercial) .*" );
+QHash<QString, QtVersionManager::QueryCache> QtVersionManager::mQueryCache;
 
 QtVersionManager::QtVersionManager( QObject* owner )
     : pSettings( owner, "QtVersions", PACKAGE_VERSION )
@@ -335,6 +336,75 @@ void QtVersionManager::setConfigurations( const QtItemList& configurations )
     endArray();
 }
 
+QString QtVersionManager::queryProperty( const QtVersion& version, const QString& name ) const
+{
+    return queryProperties( version ).value( name );
+}
+
+QHash<QString, QString> QtVersionManager::queryProperties( const QtVersion& version ) const
+{
+    if ( !version.isValid() ) {
+        return QHash<QString, QString>();
+    }
+    
+    const QString qmake = qmakeFilePath( version );
+    const QDateTime lastModified = QFileInfo( qmake ).lastModified();
+    QHash<QString, QueryCache>::const_iterator it = mQueryCache.constFind( qmake );
+    
+    if ( it != mQueryCache.constEnd() && it.value().lastModified == lastModified ) {
+        return it.value().properties;
+    }
+    
+    // one qmake call for all properties, output lines are NAME:value
+    QueryCache cache;
+    QProcess process;
+    
+    cache.lastModified = lastModified;
+    
+    process.start( QString( "\"%1\" -query" ).arg( qmake ) );
+    process.waitForFinished();
+    
+    foreach ( const QString& line, QString::fromLocal8Bit( process.readAll() ).split( '\n', QString::SkipEmptyParts ) ) {
+        const int index = line.indexOf( ':' );
+        
+        if ( index > 0 ) {
+            const QString value = line.mid( index +1 ).trimmed();
+            cache.properties[ line.left( index ).trimmed() ] = value == "**Unknown**" ? QString::null : value;
+        }
+    }
+    
+    mQueryCache[ qmake ] = cache;
+    return cache.properties;
+}
+
+QString QtVersionManager::qmakeFilePath( const QtVersion& version )
+{
+    const QString qmake = version.qmake();
+    
+    if ( !version.Path.isEmpty() ) {
+        return qmake;
+    }
+    
+    // qmake available in PATH
+#ifdef Q_OS_WIN
+    const QChar separator = ';';
+    const QString suffix = ".exe";
+#else
+    const QChar separator = ':';
+    const QString suffix;
+#endif
+    
+    foreach ( const QString& path, QString::fromLocal8Bit( qgetenv( "PATH" ) ).split( separator, QString::SkipEmptyParts ) ) {
+        const QFileInfo file( QDir( path ).filePath( qmake +suffix ) );
+        
+        if ( file.exists() ) {
+            return file.absoluteFilePath();
+        }
+    }
+    
+    return qmake;
+}
+
 #if defined( Q_OS_WIN )
 QStringList QtVersionManager::possibleQtPaths() const
 {
@@ -24,6 +24,8 @@
 #include <QStringList>
 #include <QFile>
 #include <QDomDocument>
+#include <QDateTime>
+#include <QHash>
 
 class MkSShellInterpreter;
 
@@ -169,7 +171,19 @@ public:
     QtItemList configurations() const;
     void setConfigurations( const QtItemList& configurations );
 
+    QString queryProperty( const QtVersion& version, const QString& name ) const;
+    QHash<QString, QString> queryProperties( const QtVersion& version ) const;
+
 protected:
+    struct QueryCache
+    {
+        QDateTime lastModified;
+        QHash<QString, QString> properties;
+    };
+    
+    // qmake -query results shared by all projects, keyed by qmake binary
+    static QHash<QString, QueryCache> mQueryCache;
+    
     static const QString mQtVersionKey;
     static const QString mQtModuleKey;
     static const QString mQtConfigurationKey;
@@ -178,6 +192,7 @@ protected:
     static const QRegExp mQtUninstallRegExp;
 
     QStringList possibleQtPaths() const;
+    static QString qmakeFilePath( const QtVersion& version );
     QtVersionList getQtVersions( const QStringList& paths ) const;
     void synchronizeVersions();
 
@@ -32,7 +32,9 @@ HEADERS *= src/qCtagsSense.h \
     src/qCtagsSenseUtils.h \
     src/qCtagsSenseKindFinder.h \
     src/qCtagsSenseExport.h \
-    src/qCtagsSenseSearchModel.h
+    src/qCtagsSenseSearchModel.h \
+    src/qCtagsSenseTagger.h \
+    src/qCtagsSenseBenchmark.h
 
 SOURCES *= src/qCtagsSense.cpp \
     src/qCtagsSenseIndexer.cpp \
@@ -43,4 +45,6 @@ SOURCES *= src/qCtagsSense.cpp \
     src/qCtagsSenseLanguagesModel.cpp \
     src/qCtagsSenseUtils.cpp \
     src/qCtagsSenseKindFinder.cpp \
-    src/qCtagsSenseSearchModel.cpp
\ No newline at end of file
+    src/qCtagsSenseSearchModel.cpp \
+    src/qCtagsSenseTagger.cpp \
+    src/qCtagsSenseBenchmark.cpp
\ No newline at end of file
@@ -87,6 +87,7 @@ void qCtagsSense::setProperties( const qCtagsSenseProperties& properties )
         {
             mProperties = properties;
             mIndexer->setFilteredSuffixes( properties.FilteredSuffixes );
+            mIndexer->setWorkers( properties.IndexerWorkers );
             
             foreach ( const QString& path, properties.SystemPaths )
             {
@@ -118,6 +119,17 @@ void qCtagsSense::tagEntries( const QStringList& fileNames )
     mIndexer->indexFiles( fileNames );
 }
 
+void qCtagsSense::tagProjectEntries( const QString& path, const QStringList& fileNames )
+{
+    if ( !mInitialized )
+    {
+        qWarning() << "qCtagsSense instance not initialized";
+        return;
+    }
+    
+    mIndexer->indexProjectFiles( path, fileNames );
+}
+
 void qCtagsSense::tagEntries( const QMap<QString, QString>& entries )
 {
     if ( !mInitialized )
@@ -33,18 +33,20 @@ class qCtagsSenseIndexer;
 struct QCTAGSSENSE_EXPORT qCtagsSenseProperties
 {
     qCtagsSenseProperties( const QStringList& systemPaths = QStringList(), const QStringList filteredSuffixes = QStringList(),
-        bool usePhysicalDatabase = false, const QString& databaseFileName = QString::null )
+        bool usePhysicalDatabase = false, const QString& databaseFileName = QString::null, int indexerWorkers = 0 )
     {
         SystemPaths = systemPaths;
         FilteredSuffixes = filteredSuffixes;
         UsePhysicalDatabase = usePhysicalDatabase;
         DatabaseFileName = databaseFileName;
+        IndexerWorkers = indexerWorkers;
     }
     
     bool operator==( const qCtagsSenseProperties& other ) const
     {
         return SystemPaths == other.SystemPaths && FilteredSuffixes == other.FilteredSuffixes &&
-            UsePhysicalDatabase == other.UsePhysicalDatabase && DatabaseFileName == other.DatabaseFileName;
+            UsePhysicalDatabase == other.UsePhysicalDatabase && DatabaseFileName == other.DatabaseFileName &&
+            IndexerWorkers == other.IndexerWorkers;
     }
     
     bool operator!=( const qCtagsSenseProperties& other ) const
@@ -56,6 +58,7 @@ struct QCTAGSSENSE_EXPORT qCtagsSenseProperties
     QStringList FilteredSuffixes;
     bool UsePhysicalDatabase;
     QString DatabaseFileName;
+    int IndexerWorkers; // 0 means one per cpu core
 };
 
 class QCTAGSSENSE_EXPORT qCtagsSense : public QObject
@@ -181,6 +184,7 @@ public slots:
     void setProperties( const qCtagsSenseProperties& properties );
     void tagEntry( const QString& fileName );
     void tagEntries( const QStringList& fileNames );
+    void tagProjectEntries( const QString& path, const QStringList& fileNames );
     void tagEntries( const QMap<QString, QString>& entries );
 
 protected:
@@ -0,0 +1,430 @@
+/****************************************************************************
+    Copyright (C) 2005 - 2011  Filipe AZEVEDO & The Monkey Studio Team
+    http://monkeystudio.org licensing under the GNU GPL.
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+****************************************************************************/
+#include "qCtagsSenseBenchmark.h"
+#include "qCtagsSense.h"
+#include "qCtagsSenseSQL.h"
+#include "qCtagsSenseIndexer.h"
+#include "qCtagsSenseUtils.h"
+
+extern "C" {
+    #include <exuberantCtags.h>
+}
+
+#include <QThread>
+#include <QMutex>
+#include <QFile>
+#include <QFileInfo>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QVariant>
+#include <QDebug>
+
+#ifndef CTAGS_REENTRANT
+static QMutex ctagsMutex;
+#endif
+
+/*
+    Parses the loaded files from memory, the files are shared between the taggers.
+*/
+class qCtagsSenseBenchmarkTagger : public QThread
+{
+public:
+    qCtagsSenseBenchmarkTagger( qCtagsSenseBenchmark* benchmark )
+        : QThread()
+    {
+        mBenchmark = benchmark;
+        mTags = 0;
+    }
+    
+    qint64 tags() const
+    {
+        return mTags;
+    }
+
+protected:
+    qCtagsSenseBenchmark* mBenchmark;
+    qint64 mTags;
+    
+    virtual void run()
+    {
+        int index;
+        
+        while ( ( index = mBenchmark->mNextFile.fetchAndAddOrdered( 1 ) ) < mBenchmark->mFileNames.count() )
+        {
+            const QByteArray& content = mBenchmark->mContents.at( index );
+#ifndef CTAGS_REENTRANT
+            QMutexLocker locker( &ctagsMutex );
+#endif
+            TagEntryListItem* item = createBufferTagEntryListItem( mBenchmark->mFileNames.at( index ).toLocal8Bit().constData(), content.constData(), content.size(), 0 );
+            
+            for ( TagEntryListItem* it = item; it; it = it->next )
+            {
+                mTags++;
+            }
+            
+            freeTagEntryListItem( item );
+        }
+        
+#ifndef CTAGS_REENTRANT
+        QMutexLocker locker( &ctagsMutex );
+#endif
+        freeCtagsThreadResources();
+    }
+};
+
+qCtagsSenseBenchmark::qCtagsSenseBenchmark()
+{
+    mSense = new qCtagsSense;
+}
+
+qCtagsSenseBenchmark::~qCtagsSenseBenchmark()
+{
+    delete mSense;
+}
+
+/*
+    Load the source files of paths, the directories are walked recursively
+    and the files ctags has no parser for are skipped.
+    Return the number of loaded files.
+*/
+int qCtagsSenseBenchmark::loadFiles( const QStringList& paths )
+{
+    QFileInfoList files;
+    
+    mFileNames.clear();
+    mContents.clear();
+    
+    foreach ( const QString& path, paths )
+    {
+        const QFileInfo info( path );
+        
+        if ( info.isDir() )
+        {
+            files << qCtagsSenseUtils::getFiles( QDir( path ), QStringList( "*" ), true );
+        }
+        else
+        {
+            files << info;
+        }
+    }
+    
+    foreach ( const QFileInfo& info, files )
+    {
+        const QString fileName = info.absoluteFilePath();
+        QFile file( fileName );
+        
+        if ( qstrcmp( getFileNameLanguageName( fileName.toLocal8Bit().constData() ), "unknown" ) == 0 || !file.open( QIODevice::ReadOnly ) )
+        {
+            continue;
+        }
+        
+        mFileNames << fileName;
+        mContents << file.readAll();
+    }
+    
+    return mFileNames.count();
+}
+
+/*
+    Parse the loaded files with workers threads, nothing is written.
+    Return the number of tags.
+*/
+qint64 qCtagsSenseBenchmark::tagging( int workers, qint64& elapsed )
+{
+    QList<qCtagsSenseBenchmarkTagger*> taggers;
+    QElapsedTimer timer;
+    qint64 tags = 0;
+    
+    mNextFile.fetchAndStoreOrdered( 0 );
+    timer.start();
+    
+    for ( int i = 0; i < workers; i++ )
+    {
+        qCtagsSenseBenchmarkTagger* tagger = new qCtagsSenseBenchmarkTagger( this );
+        taggers << tagger;
+        tagger->start();
+    }
+    
+    foreach ( qCtagsSenseBenchmarkTagger* tagger, taggers )
+    {
+        tagger->wait();
+        tags += tagger->tags();
+    }
+    
+    elapsed = timer.elapsed();
+    qDeleteAll( taggers );
+    
+    return tags;
+}
+
+// a new memory database each time, the files are never seen as unchanged
+bool qCtagsSenseBenchmark::resetDatabase( int workers )
+{
+    qCtagsSenseProperties properties;
+    properties.IndexerWorkers = workers;
+    
+    mSense->setProperties( qCtagsSenseProperties( QStringList(), QStringList( "*" ) ) );
+    mSense->setProperties( properties );
+    
+    return mSense->isValid();
+}
+
+// the writing path of the indexer before the batched queries
+bool qCtagsSenseBenchmark::writeTagsPerRow( const QMap<QString, TagEntryListItem*>& tags )
+{
+    QSqlQuery q = mSense->sql()->query();
+    const QString sql = QString(
+        "INSERT INTO entries "
+        "( file_id, line_number_entry, line_number, is_file_scope, is_file_entry, truncate_line, "
+        "name, kind, access, file_scope, implementation, inheritance, scope_value, "
+        "scope_key, signature, type, type_name ) "
+        "VALUES( ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ? )"
+    );
+    
+    foreach ( const QString& fileName, tags.keys() )
+    {
+        TagEntryListItem* item = tags[ fileName ];
+        
+        if ( !q.exec( QString( "DELETE FROM files WHERE filename = '%1'" ).arg( fileName ) ) )
+        {
+            qWarning() << q.lastError().text();
+            return false;
+        }
+        
+        q.prepare( "INSERT INTO files (filename, language) VALUES( ?, ? )" );
+        q.addBindValue( fileName );
+        q.addBindValue( QString::fromLocal8Bit( item->tag.language ) );
+        
+        if ( !q.exec() )
+        {
+            qWarning() << q.lastError().text();
+            return false;
+        }
+        
+        const int fileId = q.lastInsertId().toInt();
+        
+        for ( ; item; item = item->next )
+        {
+            tagEntryInfo* entry = &item->tag;
+            
+            q.prepare( sql );
+            q.addBindValue( fileId );
+            q.addBindValue( entry->lineNumberEntry -1 );
+            q.addBindValue( QVariant::fromValue( entry->lineNumber -1 ) );
+            q.addBindValue( entry->isFileScope );
+            q.addBindValue( entry->isFileEntry );
+            q.addBindValue( entry->truncateLine );
+            q.addBindValue( entry->name );
+            q.addBindValue( qCtagsSenseUtils::kindType( QChar( entry->kind ), entry->language ) );
+            q.addBindValue( entry->extensionFields.access );
+            q.addBindValue( entry->extensionFields.fileScope );
+            q.addBindValue( entry->extensionFields.implementation );
+            q.addBindValue( entry->extensionFields.inheritance );
+            q.addBindValue( entry->extensionFields.scope[ 0 ] );
+            q.addBindValue( entry->extensionFields.scope[ 1 ] );
+            q.addBindValue( entry->extensionFields.signature );
+            q.addBindValue( entry->extensionFields.typeRef[ 0 ] );
+            q.addBindValue( entry->extensionFields.typeRef[ 1 ] );
+            
+            if ( !q.exec() )
+            {
+                qWarning() << q.lastError().text();
+                return false;
+            }
+        }
+    }
+    
+    return true;
+}
+
+/*
+    Index the loaded files in a new memory database with workers taggers.
+    Return the number of written tags, or -1 on error.
+*/
+qint64 qCtagsSenseBenchmark::indexing( int workers, qint64& elapsed )
+{
+    QElapsedTimer timer;
+    
+    if ( !resetDatabase( workers ) )
+    {
+        return -1;
+    }
+    
+    timer.start();
+    mSense->tagEntries( mFileNames );
+    mSense->indexer()->wait();
+    elapsed = timer.elapsed();
+    
+    QSqlQuery q = mSense->sql()->query();
+    
+    if ( !q.exec( "SELECT COUNT(*) FROM entries" ) || !q.next() )
+    {
+        return -1;
+    }
+    
+    return q.value( 0 ).toLongLong();
+}
+
+/*
+    Write the tags of the loaded files in a new memory database in one transaction,
+    the files are parsed before the timing starts.
+    Return the number of written tags, or -1 on error.
+*/
+qint64 qCtagsSenseBenchmark::writing( bool batched, qint64& elapsed )
+{
+    QMap<QString, TagEntryListItem*> tags;
+    
+    if ( !resetDatabase() )
+    {
+        return -1;
+    }
+    
+    for ( int i = 0; i < mFileNames.count(); i++ )
+    {
+        TagEntryListItem* item = createBufferTagEntryListItem( mFileNames.at( i ).toLocal8Bit().constData(), mContents.at( i ).constData(), mContents.at( i ).size(), 0 );
+        
+        if ( item )
+        {
+            tags[ mFileNames.at( i ) ] = item;
+        }
+    }
+    
+    qCtagsSenseIndexer* indexer = mSense->indexer();
+    QSqlDatabase db = mSense->sql()->database();
+    QElapsedTimer timer;
+    bool ok;
+    
+    timer.start();
+    db.transaction();
+    
+    if ( batched )
+    {
+        ok = indexer->prepareQueries() && indexer->indexTags( tags ) && indexer->flushEntries();
+        indexer->releaseQueries();
+    }
+    else
+    {
+        ok = writeTagsPerRow( tags );
+    }
+    
+    ok = ok && db.commit();
+    elapsed = timer.elapsed();
+    
+    foreach ( TagEntryListItem* item, tags )
+    {
+        freeTagEntryListItem( item );
+    }
+    
+    QSqlQuery q = mSense->sql()->query();
+    
+    if ( !ok || !q.exec( "SELECT COUNT(*) FROM entries" ) || !q.next() )
+    {
+        return -1;
+    }
+    
+    return q.value( 0 ).toLongLong();
+}
+
+/*
+    Run the benchmark on the files of paths.
+    Return the process exit code.
+*/
+int qCtagsSenseBenchmark::exec( const QStringList& paths )
+{
+    if ( loadFiles( paths ) == 0 )
+    {
+        qWarning( "No source file to index (-benchmark-indexer path1 ...)" );
+        return 1;
+    }
+    
+    qint64 bytes = 0;
+    
+    foreach ( const QByteArray& content, mContents )
+    {
+        bytes += content.size();
+    }
+    
+    qWarning( "%d files, %.2f MiB, %d cpu cores", mFileNames.count(), bytes /( 1024.0 *1024.0 ), QThread::idealThreadCount() );
+    
+#ifndef CTAGS_REENTRANT
+    qWarning( "ctags is not reentrant on this platform, the files are parsed one at a time" );
+#endif
+    
+    QList<int> workers;
+    
+    for ( int count = 1; count < QThread::idealThreadCount(); count *= 2 )
+    {
+        workers << count;
+    }
+    
+    workers << qMax( 1, QThread::idealThreadCount() );
+    
+    for ( int stage = 0; stage < 2; stage++ )
+    {
+        double reference = 0;
+        
+        foreach ( int count, workers )
+        {
+            qint64 elapsed = 0;
+            const qint64 tags = stage == 0 ? tagging( count, elapsed ) : indexing( count, elapsed );
+            const double seconds = qMax( elapsed, qint64( 1 ) ) /1000.0;
+            
+            if ( tags == -1 )
+            {
+                qWarning( "Can't index the files" );
+                return 1;
+            }
+            
+            if ( reference == 0 )
+            {
+                reference = seconds;
+            }
+            
+            qWarning( "%s, %d workers: %lld tags in %lld ms, %.0f tags/s, speedup %.2fx",
+                stage == 0 ? "tagging" : "indexing", count, tags, elapsed, tags /seconds, reference /seconds );
+        }
+    }
+    
+    double reference = 0;
+    
+    for ( int batched = 0; batched < 2; batched++ )
+    {
+        qint64 elapsed = 0;
+        const qint64 tags = writing( batched, elapsed );
+        const double seconds = qMax( elapsed, qint64( 1 ) ) /1000.0;
+        
+        if ( tags == -1 )
+        {
+            qWarning( "Can't write the tags" );
+            return 1;
+        }
+        
+        if ( reference == 0 )
+        {
+            reference = seconds;
+        }
+        
+        qWarning( "writing, %s: %lld tags in %lld ms, %.0f tags/s, speedup %.2fx",
+            batched ? "batched queries" : "query per tag", tags, elapsed, tags /seconds, reference /seconds );
+    }
+    
+    return 0;
+}
@@ -0,0 +1,63 @@
+/****************************************************************************
+    Copyright (C) 2005 - 2011  Filipe AZEVEDO & The Monkey Studio Team
+    http://monkeystudio.org licensing under the GNU GPL.
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+****************************************************************************/
+#ifndef QCTAGSSENSEBENCHMARK_H
+#define QCTAGSSENSEBENCHMARK_H
+
+#include "qCtagsSenseExport.h"
+
+#include <QStringList>
+#include <QMap>
+#include <QByteArray>
+#include <QAtomicInt>
+
+class qCtagsSense;
+struct sTagEntryListItem;
+
+/*
+    Measures the indexer on a source tree without GUI.
+    The ctags parsing alone and the whole indexing pipeline are timed for an increasing number
+    of workers, up to the cpu cores count, and the tags/s and speedup are reported on the console.
+    The database writing alone is timed with the indexer batched queries and with a statement
+    prepared for each tag, as the indexer did before.
+*/
+class QCTAGSSENSE_EXPORT qCtagsSenseBenchmark
+{
+    friend class qCtagsSenseBenchmarkTagger;
+    
+public:
+    qCtagsSenseBenchmark();
+    virtual ~qCtagsSenseBenchmark();
+    
+    int loadFiles( const QStringList& paths );
+    qint64 tagging( int workers, qint64& elapsed );
+    qint64 indexing( int workers, qint64& elapsed );
+    qint64 writing( bool batched, qint64& elapsed );
+    int exec( const QStringList& paths );
+
+protected:
+    qCtagsSense* mSense;
+    QStringList mFileNames;
+    QList<QByteArray> mContents;
+    QAtomicInt mNextFile;
+    
+    bool resetDatabase( int workers = 0 );
+    bool writeTagsPerRow( const QMap<QString, sTagEntryListItem*>& tags );
+};
+
+#endif // QCTAGSSENSEBENCHMARK_H
@@ -299,6 +299,11 @@ void qCtagsSenseBrowser::tagEntries( const QStringList& fileNames )
     mSense->tagEntries( fileNames );
 }
 
+void qCtagsSenseBrowser::tagProjectEntries( const QString& path, const QStringList& fileNames )
+{
+    mSense->tagProjectEntries( path, fileNames );
+}
+
 void qCtagsSenseBrowser::tagEntries( const QMap<QString, QString>& entries )
 {
     mSense->tagEntries( entries );
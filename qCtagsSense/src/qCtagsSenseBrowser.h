@@ -55,6 +55,7 @@ public slots:
     void setCurrentFileName( const QString& fileName );
     void tagEntry( const QString& fileName );
     void tagEntries( const QStringList& fileNames );
+    void tagProjectEntries( const QString& path, const QStringList& fileNames );
     void tagEntries( const QMap<QString, QString>& entries );
 
 protected:
@@ -20,23 +20,41 @@
 #include "qCtagsSense.h"
 #include "qCtagsSenseUtils.h"
 #include "qCtagsSenseSQL.h"
+#include "qCtagsSenseTagger.h"
 
 #include <QMutexLocker>
 #include <QVariant>
+#include <QCryptographicHash>
 #include <QSqlError>
 #include <QDebug>
 
+#ifndef CTAGS_REENTRANT
+// without thread local storage the ctags parsers keep their state in globals, only one file can be parsed at a time
+static QMutex ctagsMutex;
+#endif
+
+// number of columns filled by createEntries()
+static const int EntriesColumns = 17;
+// number of pending entries that triggers a batch insertion
+static const int EntriesBatchSize = 4096;
+
 qCtagsSenseIndexer::qCtagsSenseIndexer( qCtagsSenseSQL* parent )
     : QThread( parent )
 {
     mStop = false;
     mSQL = parent;
+    mWorkers = 0;
+    mTaggedFilesMaximum = 0;
+    mRunningTaggers = 0;
+    mPendingEntriesCount = 0;
+    mRemovedEntries = false;
 }
 
 qCtagsSenseIndexer::~qCtagsSenseIndexer()
 {
     mStop = true;
     wait();
+    releaseQueries();
 }
 
 void qCtagsSenseIndexer::clear()
@@ -47,8 +65,11 @@ void qCtagsSenseIndexer::clear()
     mFilteredSuffixes.clear();
     mWaitingDeletion.clear();
     mWaitingIndexation.clear();
+    mWaitingPruning.clear();
+    mProjectsFiles.clear();
     mStop = true;
     wait();
+    releaseQueries();
     mStop = wasStopped;
 }
 
@@ -59,6 +80,13 @@ QStringList qCtagsSenseIndexer::filteredSuffixes() const
     return mFilteredSuffixes;
 }
 
+int qCtagsSenseIndexer::workers() const
+{
+    QMutexLocker locker( &const_cast<qCtagsSenseIndexer*>( this )->mMutex );
+    
+    return mWorkers;
+}
+
 void qCtagsSenseIndexer::addFilteredSuffixes( const QStringList& suffixes )
 {
     QMutexLocker locker( &mMutex );
@@ -89,6 +117,13 @@ void qCtagsSenseIndexer::setFilteredSuffix( const QString& suffix )
     setFilteredSuffixes( QStringList( suffix ) );
 }
 
+void qCtagsSenseIndexer::setWorkers( int count )
+{
+    QMutexLocker locker( &mMutex );
+    
+    mWorkers = count;
+}
+
 void qCtagsSenseIndexer::removeFile( const QString& fileName )
 {
     if ( mStop )
@@ -118,11 +153,32 @@ void qCtagsSenseIndexer::indexFile( const QString& fileName )
         return;
     }
     
+    indexFiles( QStringList( fileName ) );
+}
+
+void qCtagsSenseIndexer::indexFiles( const QStringList& fileNames )
+{
+    if ( mStop )
+    {
+        return;
+    }
+    
     QMutexLocker locker( &mMutex );
     
-    if ( !mWaitingIndexation.contains( fileName ) && QFile::exists( fileName ) )
+    foreach ( const QString& fileName, fileNames )
     {
-        mWaitingIndexation[ fileName ] = QString::null;
+        if ( QFile::exists( fileName ) )
+        {
+            if ( !mWaitingIndexation.contains( fileName ) )
+            {
+                mWaitingIndexation[ fileName ] = QString::null;
+            }
+        }
+        // the file is gone, its entries must not survive it
+        else if ( !mWaitingDeletion.contains( fileName ) )
+        {
+            mWaitingDeletion << fileName;
+        }
     }
     
     locker.unlock();
@@ -133,7 +189,7 @@ void qCtagsSenseIndexer::indexFile( const QString& fileName )
     }
 }
 
-void qCtagsSenseIndexer::indexFiles( const QStringList& fileNames )
+void qCtagsSenseIndexer::indexProjectFiles( const QString& path, const QStringList& fileNames )
 {
     if ( mStop )
     {
@@ -142,20 +198,35 @@ void qCtagsSenseIndexer::indexFiles( const QStringList& fileNames )
     
     QMutexLocker locker( &mMutex );
     
-    foreach ( const QString& fileName, fileNames )
+    const QString projectPath = QDir( path ).absolutePath();
+    const QSet<QString> files = fileNames.toSet();
+    QSet<QString> removedFiles = mProjectsFiles.value( projectPath ) -files;
+    
+    mProjectsFiles[ projectPath ] = files;
+    
+    // the files removed from the project are kept while another opened project has them
+    foreach ( const QSet<QString>& projectFiles, mProjectsFiles )
     {
-        if ( !mWaitingIndexation.contains( fileName ) && QFile::exists( fileName ) )
+        removedFiles -= projectFiles;
+    }
+    
+    foreach ( const QString& fileName, removedFiles )
+    {
+        if ( !mWaitingDeletion.contains( fileName ) )
         {
-            mWaitingIndexation[ fileName ] = QString::null;
+            mWaitingDeletion << fileName;
         }
     }
     
-    locker.unlock();
-
-    if ( !isRunning() )
+    // the files deleted from the disk are removed whatever project indexed them
+    if ( !mWaitingPruning.contains( projectPath ) )
     {
-        start();
+        mWaitingPruning << projectPath;
     }
+    
+    locker.unlock();
+    
+    indexFiles( fileNames );
 }
 
 void qCtagsSenseIndexer::indexBuffers( const QMap<QString, QString>& buffers )
@@ -196,30 +267,241 @@ void qCtagsSenseIndexer::indexBuffers( const QMap<QString, QString>& buffers )
 
 // PROTECTED
 
-bool qCtagsSenseIndexer::removeEntries( const QStringList& fileNames )
+bool qCtagsSenseIndexer::prepareQueries()
+{
+    releaseQueries();
+    
+    mRemoveFileQuery = mSQL->query();
+    mRemovePathQuery = mSQL->query();
+    mFileQuery = mSQL->query();
+    mTouchFileQuery = mSQL->query();
+    mEntriesQuery = mSQL->query();
+    mNamesQuery = mSQL->query();
+    mNameTrigramsQuery = mSQL->query();
+    
+    const QString entries_sql = QString(
+        "INSERT INTO entries "
+        "( file_id, line_number_entry, line_number, is_file_scope, is_file_entry, truncate_line, "
+        "name, kind, access, file_scope, implementation, inheritance, scope_value, "
+        "scope_key, signature, type, type_name ) "
+        "VALUES( ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ? )"
+    );
+    
+    if ( !mRemoveFileQuery.prepare( "DELETE FROM files WHERE filename = ?" ) ||
+        !mRemovePathQuery.prepare( "DELETE FROM files WHERE substr( filename, 1, ? ) = ?" ) ||
+        !mFileQuery.prepare( "INSERT INTO files (filename, language, size, mtime, hash) VALUES( ?, ?, ?, ?, ? )" ) ||
+        !mTouchFileQuery.prepare( "UPDATE files SET size = ?, mtime = ? WHERE filename = ?" ) ||
+        !mEntriesQuery.prepare( entries_sql ) ||
+        !mNamesQuery.prepare( "INSERT OR IGNORE INTO names (name) VALUES( ? )" ) ||
+        !mNameTrigramsQuery.prepare( "INSERT OR IGNORE INTO name_trigrams (trigram, name) VALUES( ?, ? )" ) )
+    {
+        qWarning() << "Can't prepare indexer queries";
+        releaseQueries();
+        return false;
+    }
+    
+    for ( int i = 0; i < EntriesColumns; i++ )
+    {
+        mPendingEntries << QVariantList();
+    }
+    
+    return true;
+}
+
+void qCtagsSenseIndexer::releaseQueries()
+{
+    mRemoveFileQuery = QSqlQuery();
+    mRemovePathQuery = QSqlQuery();
+    mFileQuery = QSqlQuery();
+    mTouchFileQuery = QSqlQuery();
+    mEntriesQuery = QSqlQuery();
+    mNamesQuery = QSqlQuery();
+    mNameTrigramsQuery = QSqlQuery();
+    mPendingEntries.clear();
+    mPendingEntriesCount = 0;
+    mPendingFiles.clear();
+    mPendingNames.clear();
+    mPendingTrigrams.clear();
+    mPendingTrigramsNames.clear();
+    mIndexedNames.clear();
+    mRemovedEntries = false;
+}
+
+bool qCtagsSenseIndexer::flushEntries()
+{
+    if ( mPendingEntriesCount == 0 )
+    {
+        mPendingFiles.clear();
+        return true;
+    }
+    
+    for ( int i = 0; i < EntriesColumns; i++ )
+    {
+        mEntriesQuery.bindValue( i, mPendingEntries[ i ] );
+        mPendingEntries[ i ].clear();
+    }
+    
+    mPendingEntriesCount = 0;
+    mPendingFiles.clear();
+    
+    if ( !mEntriesQuery.execBatch() )
+    {
+        qWarning() << "Can't create entries";
+        qWarning() << mEntriesQuery.lastError().text();
+        return false;
+    }
+    
+    // search tables
+    if ( !mPendingNames.isEmpty() )
+    {
+        mNamesQuery.bindValue( 0, mPendingNames );
+        mPendingNames.clear();
+        
+        if ( !mNamesQuery.execBatch() )
+        {
+            qWarning() << "Can't create names";
+            qWarning() << mNamesQuery.lastError().text();
+            return false;
+        }
+    }
+    
+    if ( !mPendingTrigrams.isEmpty() )
+    {
+        mNameTrigramsQuery.bindValue( 0, mPendingTrigrams );
+        mNameTrigramsQuery.bindValue( 1, mPendingTrigramsNames );
+        mPendingTrigrams.clear();
+        mPendingTrigramsNames.clear();
+        
+        if ( !mNameTrigramsQuery.execBatch() )
+        {
+            qWarning() << "Can't create names trigrams";
+            qWarning() << mNameTrigramsQuery.lastError().text();
+            return false;
+        }
+    }
+    
+    return true;
+}
+
+bool qCtagsSenseIndexer::removeOrphanNames()
 {
+    // the names having no entries left are found from the entries name index
     QSqlQuery q = mSQL->query();
-    QString del_sql;
+    q.setForwardOnly( true );
     
-    foreach ( QString fileName, fileNames )
+    if ( !q.exec( "SELECT name FROM names WHERE NOT EXISTS ( SELECT 1 FROM entries WHERE entries.name = names.name )" ) )
     {
-        QFileInfo file( fileName );
+        qWarning() << "Can't get orphan names";
+        qWarning() << q.lastError().text();
+        return false;
+    }
+    
+    QVariantList names;
+    QVariantList trigrams;
+    QVariantList trigramsNames;
+    
+    while ( q.next() )
+    {
+        const QString name = q.value( 0 ).toString();
+        names << name;
         
-        if ( file.isFile() )
+        foreach ( const QString& trigram, qCtagsSenseUtils::trigrams( name ) )
         {
-            del_sql = QString( "DELETE FROM Files WHERE filename = '%1'" ).arg( fileName );
+            trigrams << trigram;
+            trigramsNames << name;
         }
-        else
+        
+        mIndexedNames.remove( name );
+    }
+    
+    q.finish();
+    
+    if ( names.isEmpty() )
+    {
+        return true;
+    }
+    
+    // the trigrams rows are deleted from their unique index
+    if ( !trigrams.isEmpty() )
+    {
+        if ( !q.prepare( "DELETE FROM name_trigrams WHERE trigram = ? AND name = ?" ) )
+        {
+            qWarning() << "Can't prepare orphan names trigrams deletion";
+            return false;
+        }
+        
+        q.bindValue( 0, trigrams );
+        q.bindValue( 1, trigramsNames );
+        
+        if ( !q.execBatch() )
+        {
+            qWarning() << "Can't delete orphan names trigrams";
+            qWarning() << q.lastError().text();
+            return false;
+        }
+    }
+    
+    if ( !q.prepare( "DELETE FROM names WHERE name = ?" ) )
+    {
+        qWarning() << "Can't prepare orphan names deletion";
+        return false;
+    }
+    
+    q.bindValue( 0, names );
+    
+    if ( !q.execBatch() )
+    {
+        qWarning() << "Can't delete orphan names";
+        qWarning() << q.lastError().text();
+        return false;
+    }
+    
+    return true;
+}
+
+bool qCtagsSenseIndexer::removeEntries( const QStringList& fileNames )
+{
+    foreach ( const QString& fileName, fileNames )
+    {
+        QFileInfo file( fileName );
+        
+        // pending entries of a removed file must be written first so the files trigger can delete them
+        if ( mPendingFiles.contains( fileName ) || !file.isFile() )
         {
-            del_sql = QString( "DELETE FROM Files WHERE filename LIKE '%1/%'" ).arg( fileName );
+            if ( !flushEntries() )
+            {
+                return false;
+            }
         }
         
-        if ( !q.exec( del_sql ) )
+        mRemoveFileQuery.bindValue( 0, fileName );
+        
+        if ( !mRemoveFileQuery.exec() )
         {
             qWarning() << "Can't delete file entry for" << fileName.toLocal8Bit().constData();
             return false;
         }
         
+        mRemovedEntries = mRemovedEntries || mRemoveFileQuery.numRowsAffected() > 0;
+        
+        // a path that is not a file anymore may be a directory, or a removed one
+        if ( !file.isFile() )
+        {
+            const QString prefix = QString( "%1/" ).arg( fileName );
+            
+            // not a LIKE pattern, it is case insensitive and the file names may contain its wildcards
+            mRemovePathQuery.bindValue( 0, prefix.length() );
+            mRemovePathQuery.bindValue( 1, prefix );
+            
+            if ( !mRemovePathQuery.exec() )
+            {
+                qWarning() << "Can't delete files entries for" << fileName.toLocal8Bit().constData();
+                return false;
+            }
+            
+            mRemovedEntries = mRemovedEntries || mRemovePathQuery.numRowsAffected() > 0;
+        }
+        
         if ( mStop )
         {
             return false;
@@ -229,50 +511,320 @@ bool qCtagsSenseIndexer::removeEntries( const QStringList& fileNames )
     return true;
 }
 
-bool qCtagsSenseIndexer::indexEntry( const QString& fileName )
+bool qCtagsSenseIndexer::indexFileEntries( const QStringList& fileNames, int& value, int total, bool& changed, bool& error )
 {
-    QMap<QString, TagEntryListItem*> entries;
-    bool ok = false;
-    QFileInfo file( fileName );
+    if ( fileNames.isEmpty() )
+    {
+        return true;
+    }
+    
+    int count = workers();
     
-    // tag files
-    if ( file.isFile() )
+    if ( count <= 0 )
     {
-        TagEntryListItem* item = tagFileEntry( fileName, ok );
+        count = QThread::idealThreadCount();
+    }
+    
+    count = qBound( 1, count, fileNames.count() );
+    
+    // start the tagging stage
+    const QHash<QString, FileState> states = storedFileStates();
+    QList<qCtagsSenseTagger*> taggers;
+    
+    {
+        QMutexLocker locker( &mPipelineMutex );
+        
+        mFilesToTag.clear();
         
-        if ( ok && item )
+        foreach ( const QString& fileName, fileNames )
         {
-            entries[ fileName ] = item;
+            TaggedFile file( fileName );
+            file.stored = states.value( fileName );
+            mFilesToTag << file;
         }
+        
+        mTaggedFiles.clear();
+        mTaggedFilesMaximum = count *4;
+        mRunningTaggers = count;
     }
-    else if ( file.isDir() )
+    
+    for ( int i = 0; i < count; i++ )
     {
-        entries = tagPathEntries( fileName, ok );
+        qCtagsSenseTagger* tagger = new qCtagsSenseTagger( this );
+        taggers << tagger;
+        tagger->start();
     }
     
-    // index tags
-    ok = ok && indexTags( entries );
+    // the writing stage runs in this thread as it owns the database connection
+    TaggedFile file;
     
-    // free tags
-    foreach ( TagEntryListItem* item, entries )
+    while ( takeTaggedFile( file ) )
     {
-        freeTagEntryListItem( item );
+        bool ok = file.ok;
+        
+        if ( file.unchanged )
+        {
+            // only the modification time has changed
+            if ( file.state.modified != file.stored.modified )
+            {
+                ok = touchFileEntry( file.fileName, file.state );
+            }
+        }
+        else if ( ok && file.item )
+        {
+            QMap<QString, TagEntryListItem*> entries;
+            QMap<QString, FileState> states;
+            entries[ file.fileName ] = file.item;
+            states[ file.fileName ] = file.state;
+            ok = indexTags( entries, states );
+            
+            if ( ok )
+            {
+                changed = true;
+            }
+        }
+        else if ( ok && !file.state.hash.isEmpty() )
+        {
+            // the file has been read but has no tags anymore, drop its old entries and keep its state
+            const QString language = QString::fromLocal8Bit( getFileNameLanguageName( file.fileName.toLocal8Bit().constData() ) );
+            ok = removeEntries( QStringList( file.fileName ) ) && createFileEntry( file.fileName, language, file.state ) != -1;
+            
+            if ( ok )
+            {
+                changed = true;
+            }
+        }
+        
+        freeTagEntryListItem( file.item );
+        
+        if ( !ok && !error )
+        {
+            qWarning() << "Error while indexing files (" << file.fileName << ")";
+            error = true;
+        }
+        
+        value++;
+        emit indexingProgress( value, total );
         
         if ( mStop )
         {
-            return false;
+            break;
         }
     }
     
-    entries.clear();
+    // wake up taggers waiting for room in the queue so they can see the stop request
+    {
+        QMutexLocker locker( &mPipelineMutex );
+        
+        mFilesToTag.clear();
+        mTaggedConsumed.wakeAll();
+    }
     
-    return ok;
+    foreach ( qCtagsSenseTagger* tagger, taggers )
+    {
+        tagger->wait();
+    }
+    
+    qDeleteAll( taggers );
+    
+    // free tags not consumed due to a stop request
+    foreach ( const TaggedFile& taggedFile, mTaggedFiles )
+    {
+        freeTagEntryListItem( taggedFile.item );
+    }
+    
+    mTaggedFiles.clear();
+    
+    return !mStop;
+}
+
+QHash<QString, qCtagsSenseIndexer::FileState> qCtagsSenseIndexer::storedFileStates() const
+{
+    QHash<QString, FileState> states;
+    QSqlQuery q = mSQL->query();
+    
+    if ( !q.exec( "SELECT filename, size, mtime, hash FROM files WHERE hash IS NOT NULL" ) )
+    {
+        qWarning() << "Can't get files states" << q.lastError().text();
+        return states;
+    }
+    
+    while ( q.next() )
+    {
+        FileState state;
+        state.size = q.value( 1 ).toLongLong();
+        state.modified = q.value( 2 ).toLongLong();
+        state.hash = q.value( 3 ).toString().toLatin1();
+        states[ q.value( 0 ).toString() ] = state;
+    }
+    
+    return states;
+}
+
+QStringList qCtagsSenseIndexer::indexedFileNames( const QString& path ) const
+{
+    QStringList fileNames;
+    QSqlQuery q = mSQL->query();
+    const QString prefix = QString( "%1/" ).arg( path );
+    
+    // buffers have no hash and are only replaced by their files
+    q.prepare( "SELECT filename FROM files WHERE substr( filename, 1, ? ) = ? AND hash IS NOT NULL" );
+    q.addBindValue( prefix.length() );
+    q.addBindValue( prefix );
+    
+    if ( !q.exec() )
+    {
+        qWarning() << "Can't get files of" << path.toLocal8Bit().constData() << q.lastError().text();
+        return fileNames;
+    }
+    
+    while ( q.next() )
+    {
+        fileNames << q.value( 0 ).toString();
+    }
+    
+    return fileNames;
+}
+
+bool qCtagsSenseIndexer::touchFileEntry( const QString& fileName, const FileState& state )
+{
+    mTouchFileQuery.bindValue( 0, state.size );
+    mTouchFileQuery.bindValue( 1, state.modified );
+    mTouchFileQuery.bindValue( 2, fileName );
+    
+    if ( !mTouchFileQuery.exec() )
+    {
+        qWarning() << "Can't update file entry for" << fileName.toLocal8Bit().constData();
+        return false;
+    }
+    
+    return true;
+}
+
+bool qCtagsSenseIndexer::takeFileToTag( TaggedFile& file )
+{
+    QMutexLocker locker( &mPipelineMutex );
+    
+    if ( mStop || mFilesToTag.isEmpty() )
+    {
+        return false;
+    }
+    
+    file = mFilesToTag.takeFirst();
+    return true;
+}
+
+void qCtagsSenseIndexer::tagFile( TaggedFile& file )
+{
+    const QFileInfo info( file.fileName );
+    file.state.size = info.size();
+    file.state.modified = info.lastModified().toMSecsSinceEpoch();
+    
+    if ( !file.stored.isNull() )
+    {
+        // same size and modification time, consider the file unchanged without reading it
+        if ( file.state.size == file.stored.size && file.state.modified == file.stored.modified )
+        {
+            file.ok = true;
+            file.unchanged = true;
+            return;
+        }
+    }
+    
+    if ( isFilteredFile( file.fileName ) )
+    {
+        file.ok = true;
+        return;
+    }
+    
+    // read the file once, the same content is used for the hash and for the tagging
+    QFile device( file.fileName );
+    
+    if ( !device.open( QIODevice::ReadOnly ) )
+    {
+        qWarning() << "File does not exists" << file.fileName.toLocal8Bit().constData();
+        file.ok = false;
+        return;
+    }
+    
+    const QByteArray content = device.readAll();
+    device.close();
+    
+    file.state.hash = QCryptographicHash::hash( content, QCryptographicHash::Md5 ).toHex();
+    
+    if ( !file.stored.isNull() && file.state.hash == file.stored.hash )
+    {
+        file.ok = true;
+        file.unchanged = true;
+        return;
+    }
+    
+    file.item = tagBufferEntry( file.fileName, content, file.ok );
+}
+
+void qCtagsSenseIndexer::pushTaggedFile( const TaggedFile& file )
+{
+    QMutexLocker locker( &mPipelineMutex );
+    
+    while ( !mStop && mTaggedFiles.count() >= mTaggedFilesMaximum )
+    {
+        mTaggedConsumed.wait( &mPipelineMutex );
+    }
+    
+    if ( mStop )
+    {
+        locker.unlock();
+        freeTagEntryListItem( file.item );
+        return;
+    }
+    
+    mTaggedFiles << file;
+    mTaggedAvailable.wakeOne();
+}
+
+bool qCtagsSenseIndexer::takeTaggedFile( TaggedFile& file )
+{
+    QMutexLocker locker( &mPipelineMutex );
+    
+    while ( mTaggedFiles.isEmpty() && mRunningTaggers > 0 )
+    {
+        mTaggedAvailable.wait( &mPipelineMutex );
+    }
+    
+    if ( mTaggedFiles.isEmpty() )
+    {
+        return false;
+    }
+    
+    file = mTaggedFiles.takeFirst();
+    mTaggedConsumed.wakeOne();
+    return true;
+}
+
+void qCtagsSenseIndexer::freeParserResources()
+{
+#ifndef CTAGS_REENTRANT
+    // the state is global and may be in use by another thread
+    QMutexLocker locker( &ctagsMutex );
+#endif
+    freeCtagsThreadResources();
+}
+
+void qCtagsSenseIndexer::taggerFinished()
+{
+    QMutexLocker locker( &mPipelineMutex );
+    
+    mRunningTaggers--;
+    mTaggedAvailable.wakeAll();
 }
 
 bool qCtagsSenseIndexer::indexEntries( const QMap<QString, QString>& entries )
 {
     bool ok = false;
     QMap<QString, TagEntryListItem*> tagEntries = tagBuffersEntries( entries, ok );
+    
+    // the parsing state of this thread is not needed anymore
+    freeParserResources();
 
     // index tags
     ok = ok && indexTags( tagEntries );
@@ -293,62 +845,65 @@ bool qCtagsSenseIndexer::indexEntries( const QMap<QString, QString>& entries )
     return ok;
 }
 
-int qCtagsSenseIndexer::createFileEntry( const QString& fileName, const QString& language )
+int qCtagsSenseIndexer::createFileEntry( const QString& fileName, const QString& language, const FileState& state )
 {
-    QSqlQuery q = mSQL->query();
-    const QString set_sql = "INSERT INTO files (filename, language) VALUES( ?, ? )";
-    
-    q.prepare( set_sql );
-    q.addBindValue( fileName );
-    q.addBindValue( language );
+    mFileQuery.bindValue( 0, fileName );
+    mFileQuery.bindValue( 1, language );
+    // buffers have no state and will always be indexed again
+    mFileQuery.bindValue( 2, state.isNull() ? QVariant() : QVariant( state.size ) );
+    mFileQuery.bindValue( 3, state.isNull() ? QVariant() : QVariant( state.modified ) );
+    mFileQuery.bindValue( 4, state.hash.isEmpty() ? QVariant() : QVariant( QString::fromLatin1( state.hash ) ) );
     
-    if ( !q.exec() )
+    if ( !mFileQuery.exec() )
     {
         qWarning() << "Can't create file id for" << fileName.toLocal8Bit().constData();
         return -1;
     }
     
-    return q.lastInsertId().toInt();
+    mPendingFiles << fileName;
+    return mFileQuery.lastInsertId().toInt();
 }
 
 bool qCtagsSenseIndexer::createEntries( int fileId, TagEntryListItem* item )
 {
-    QSqlQuery q = mSQL->query();
-    const QString sql = QString(
-        "INSERT INTO entries "
-        "( file_id, line_number_entry, line_number, is_file_scope, is_file_entry, truncate_line, "
-        "name, kind, access, file_scope, implementation, inheritance, scope_value, "
-        "scope_key, signature, type, type_name ) "
-        "VALUES( ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ? )"
-    );
-    
     while ( item != NULL )
     {
         tagEntryInfo* entry = &item->tag;
+        const QString name( entry->name );
         
-        q.prepare( sql );
-        q.addBindValue( fileId );
-        q.addBindValue( entry->lineNumberEntry -1 );
-        q.addBindValue( QVariant::fromValue( entry->lineNumber -1 ) );
-        q.addBindValue( entry->isFileScope );
-        q.addBindValue( entry->isFileEntry );
-        q.addBindValue( entry->truncateLine );
-        q.addBindValue( entry->name );
-        q.addBindValue( qCtagsSenseUtils::kindType( QChar( entry->kind ), entry->language ) );
-        q.addBindValue( entry->extensionFields.access );
-        q.addBindValue( entry->extensionFields.fileScope );
-        q.addBindValue( entry->extensionFields.implementation );
-        q.addBindValue( entry->extensionFields.inheritance );
-        q.addBindValue( entry->extensionFields.scope[ 0 ] );
-        q.addBindValue( entry->extensionFields.scope[ 1 ] );
-        q.addBindValue( entry->extensionFields.signature );
-        q.addBindValue( entry->extensionFields.typeRef[ 0 ] );
-        q.addBindValue( entry->extensionFields.typeRef[ 1 ] );
-        
-        if ( !q.exec() )
-        {
-            qWarning() << "Can't create entry for" << entry->name;
-            qWarning() << q.lastError().text();
+        if ( !mIndexedNames.contains( name ) )
+        {
+            mIndexedNames << name;
+            mPendingNames << name;
+            
+            foreach ( const QString& trigram, qCtagsSenseUtils::trigrams( name ) )
+            {
+                mPendingTrigrams << trigram;
+                mPendingTrigramsNames << name;
+            }
+        }
+        
+        mPendingEntries[ 0 ] << fileId;
+        mPendingEntries[ 1 ] << entry->lineNumberEntry -1;
+        mPendingEntries[ 2 ] << QVariant::fromValue( entry->lineNumber -1 );
+        mPendingEntries[ 3 ] << entry->isFileScope;
+        mPendingEntries[ 4 ] << entry->isFileEntry;
+        mPendingEntries[ 5 ] << entry->truncateLine;
+        mPendingEntries[ 6 ] << name;
+        mPendingEntries[ 7 ] << qCtagsSenseUtils::kindType( QChar( entry->kind ), entry->language );
+        mPendingEntries[ 8 ] << entry->extensionFields.access;
+        mPendingEntries[ 9 ] << entry->extensionFields.fileScope;
+        mPendingEntries[ 10 ] << entry->extensionFields.implementation;
+        mPendingEntries[ 11 ] << entry->extensionFields.inheritance;
+        mPendingEntries[ 12 ] << entry->extensionFields.scope[ 0 ];
+        mPendingEntries[ 13 ] << entry->extensionFields.scope[ 1 ];
+        mPendingEntries[ 14 ] << entry->extensionFields.signature;
+        mPendingEntries[ 15 ] << entry->extensionFields.typeRef[ 0 ];
+        mPendingEntries[ 16 ] << entry->extensionFields.typeRef[ 1 ];
+        mPendingEntriesCount++;
+        
+        if ( mPendingEntriesCount >= EntriesBatchSize && !flushEntries() )
+        {
             return false;
         }
         
@@ -363,7 +918,7 @@ bool qCtagsSenseIndexer::createEntries( int fileId, TagEntryListItem* item )
     return true;
 }
 
-bool qCtagsSenseIndexer::indexTags( const QMap<QString, TagEntryListItem*>& tags )
+bool qCtagsSenseIndexer::indexTags( const QMap<QString, TagEntryListItem*>& tags, const QMap<QString, FileState>& states )
 {
     // remove already existing files entries
     if ( !removeEntries( tags.keys() ) )
@@ -377,7 +932,7 @@ bool qCtagsSenseIndexer::indexTags( const QMap<QString, TagEntryListItem*>& tags
     {
         TagEntryListItem* tag = tags[ fileName ];
         
-        int fileId = createFileEntry( fileName, QString::fromLocal8Bit( tag->tag.language ) );
+        int fileId = createFileEntry( fileName, QString::fromLocal8Bit( tag->tag.language ), states.value( fileName ) );
         
         if ( fileId == -1 )
         {
@@ -398,73 +953,35 @@ bool qCtagsSenseIndexer::indexTags( const QMap<QString, TagEntryListItem*>& tags
     return true;
 }
 
-TagEntryListItem* qCtagsSenseIndexer::tagFileEntry( const QString& fileName, bool& ok )
+bool qCtagsSenseIndexer::isFilteredFile( const QString& fileName )
 {
-    if ( !QFile::exists( fileName ) )
-    {
-        qWarning() << "File does not exists" << fileName.toLocal8Bit().constData();
-        ok = false;
-        return 0;
-    }
-    
     {
         QMutexLocker locker( &mMutex );
         
         if ( QDir::match( mFilteredSuffixes, fileName ) )
         {
-            // skipping file is not an error
-            ok = true;
-            return 0;
+            return true;
         }
     }
     
     // files with no suffixes can't be parsed
-    if ( QFileInfo( fileName ).suffix().isEmpty() )
-    {
-        ok = true;
-        return 0;
-    }
-    
-    ok = true;
-    return createTagEntryListItem( fileName.toLocal8Bit().constData(), 0 );
+    return QFileInfo( fileName ).suffix().isEmpty();
 }
 
-QMap<QString, TagEntryListItem*> qCtagsSenseIndexer::tagPathEntries( const QString& pathName, bool& ok )
+TagEntryListItem* qCtagsSenseIndexer::tagBufferEntry( const QString& fileName, const QByteArray& buffer, bool& ok )
 {
-    QMap<QString, TagEntryListItem*> entries;
-    
-    if ( !QFile::exists( pathName ) )
-    {
-        qWarning() << "Path does not exists" << pathName.toLocal8Bit().constData();
-        ok = false;
-        return entries;
-    }
+    ok = true;
     
-    QDir dir( pathName );
-
-    foreach ( const QFileInfo& file, qCtagsSenseUtils::getFiles( dir, QStringList( "*" ), true ) )
+    if ( isFilteredFile( fileName ) )
     {
-        TagEntryListItem* item = tagFileEntry( file.absoluteFilePath(), ok );
-        
-        if ( mStop )
-        {
-            ok = false;
-        }
-        
-        if ( !ok )
-        {
-            qWarning() << "Failed to index" << file.absoluteFilePath().toLocal8Bit().constData();
-            qWarning() << "Failed to index" << pathName.toLocal8Bit().constData();
-            return entries;
-        }
-        else if ( ok && item )
-        {
-            entries[ file.absoluteFilePath() ] = item;
-        }
+        // skipping file is not an error
+        return 0;
     }
     
-    ok = true;
-    return entries;
+#ifndef CTAGS_REENTRANT
+    QMutexLocker locker( &ctagsMutex );
+#endif
+    return createBufferTagEntryListItem( fileName.toLocal8Bit().constData(), buffer.constData(), buffer.size(), 0 );
 }
 
 QMap<QString, TagEntryListItem*> qCtagsSenseIndexer::tagBuffersEntries( const QMap<QString, QString>& entries, bool& ok )
@@ -473,31 +990,8 @@ QMap<QString, TagEntryListItem*> qCtagsSenseIndexer::tagBuffersEntries( const QM
     
     foreach ( const QString& fileName, entries.keys() )
     {
-        QFile  file( QString( "%1/mks_ctags_%2" ).arg( QDir::tempPath() ).arg( QFileInfo( fileName ).fileName() ) );
-        
-        if ( !file.open( QIODevice::WriteOnly ) )
-        {
-            qWarning() << "Failed to create temporary file" << fileName.toLocal8Bit().constData();
-            ok = false;
-            return tagEntries;
-        }
-        
-        file.resize( 0 );
-        
-        if ( file.write( entries[ fileName ].toUtf8() ) == -1 )
-        {
-            qWarning() << "Failed to write in temporary file" << fileName.toLocal8Bit().constData();
-            ok = false;
-            file.close();
-            file.remove();
-            return tagEntries;
-        }
-        
-        file.close();
-        
-        TagEntryListItem* item = tagFileEntry( file.fileName(), ok );
-        
-        file.remove();
+        // buffers are tagged from memory under their real name, nothing is written on disk
+        TagEntryListItem* item = tagBufferEntry( fileName, entries[ fileName ].toUtf8(), ok );
         
         if ( mStop )
         {
@@ -507,9 +1001,15 @@ QMap<QString, TagEntryListItem*> qCtagsSenseIndexer::tagBuffersEntries( const QM
         if ( !ok )
         {
             qWarning() << "Failed to index" << fileName.toLocal8Bit().constData();
+            
+            if ( item )
+            {
+                freeTagEntryListItem( item );
+            }
+            
             return tagEntries;
         }
-        else if ( ok && item )
+        else if ( item )
         {
             tagEntries[ fileName ] = item;
         }
@@ -531,6 +1031,14 @@ void qCtagsSenseIndexer::run()
     // start transaction
     mSQL->database().transaction();
     
+    // nothing can be written without the queries, the waiting files are kept for the next run
+    if ( !prepareQueries() )
+    {
+        mSQL->database().rollback();
+        emit indexingFinished();
+        return;
+    }
+    
     forever
     {
         QMutexLocker locker( &mMutex );
@@ -538,14 +1046,18 @@ void qCtagsSenseIndexer::run()
         // copy
         QStringList fileNamesToRemove = mWaitingDeletion;
         QMap<QString, QString> fileNamesToIndex = mWaitingIndexation;
+        QStringList pathsToPrune = mWaitingPruning;
         
         // clear
         mWaitingDeletion.clear();
         mWaitingIndexation.clear();
+        mWaitingPruning.clear();
         
         locker.unlock();
         
         // compute files
+        QHash<QString, QSet<QString> > directories; // path, files
+        
         foreach ( const QString& fileName, fileNamesToIndex.keys() )
         {
             if ( QFileInfo( fileName ).isDir() )
@@ -553,10 +1065,33 @@ void qCtagsSenseIndexer::run()
                 fileNamesToIndex.remove( fileName );
                 
                 QDir dir( fileName );
+                QSet<QString>& dirFileNames = directories[ dir.absolutePath() ];
                 
                 foreach ( const QFileInfo& file, qCtagsSenseUtils::getFiles( dir, QStringList( "*" ), true ) )
                 {
                     fileNamesToIndex[ file.absoluteFilePath() ] = QString::null;
+                    dirFileNames << file.absoluteFilePath();
+                }
+            }
+            
+            if ( mStop )
+            {
+                return;
+            }
+        }
+        
+        // files removed from the indexed directories, or from the disk under the projects paths
+        foreach ( const QString& path, directories.keys() +pathsToPrune )
+        {
+            const QSet<QString> directoryFileNames = directories.value( path );
+            
+            foreach ( const QString& fileName, indexedFileNames( path ) )
+            {
+                const bool removed = directories.contains( path ) && !directoryFileNames.contains( fileName );
+                
+                if ( ( removed || !QFile::exists( fileName ) ) && !fileNamesToRemove.contains( fileName ) )
+                {
+                    fileNamesToRemove << fileName;
                 }
             }
             
@@ -594,32 +1129,22 @@ void qCtagsSenseIndexer::run()
         // indexation
         while ( !fileNamesToIndex.isEmpty() )
         {
+            QStringList fileNames;
+            
             foreach ( const QString& fileName, fileNamesToIndex.keys() )
             {
                 if ( fileNamesToIndex[ fileName ].isNull() )
                 {
-                    if ( indexEntry( fileName ) )
-                    {
-                        changed = true;
-                    }
-                    else if ( !error )
-                    {
-                        qWarning() << "Error while indexing files (" << fileName << ")";
-                        error = true;
-                    }
-                    
+                    fileNames << fileName;
                     fileNamesToIndex.remove( fileName );
-                    
-                    value++;
-                    emit indexingProgress( value, total );
-                }
-                
-                if ( mStop )
-                {
-                    return;
                 }
             }
             
+            if ( !indexFileEntries( fileNames, value, total, changed, error ) )
+            {
+                return;
+            }
+            
             if ( !fileNamesToIndex.isEmpty() )
             {
                 if ( indexEntries( fileNamesToIndex ) )
@@ -650,7 +1175,7 @@ void qCtagsSenseIndexer::run()
         {
             return;
         }
-        else if ( !mWaitingDeletion.isEmpty() || !mWaitingIndexation.isEmpty() )
+        else if ( !mWaitingDeletion.isEmpty() || !mWaitingIndexation.isEmpty() || !mWaitingPruning.isEmpty() )
         {
             continue;
         }
@@ -658,6 +1183,20 @@ void qCtagsSenseIndexer::run()
         break;
     }
     
+    // write remaining entries
+    if ( !error && !flushEntries() )
+    {
+        error = true;
+    }
+    
+    // the search tables only keep the names still having entries
+    if ( !error && mRemovedEntries && !removeOrphanNames() )
+    {
+        error = true;
+    }
+    
+    releaseQueries();
+    
     if ( error )
     {
         // rollback transaction
@@ -23,18 +23,26 @@
 
 #include <QThread>
 #include <QMutex>
+#include <QWaitCondition>
 #include <QMap>
 #include <QStringList>
+#include <QSet>
+#include <QHash>
+#include <QVariant>
+#include <QSqlQuery>
 
 extern "C" {
     #include <exuberantCtags.h>
 }
 
 class qCtagsSenseSQL;
+class qCtagsSenseTagger;
 
 class QCTAGSSENSE_EXPORT qCtagsSenseIndexer : public QThread
 {
     Q_OBJECT
+    friend class qCtagsSenseTagger;
+    friend class qCtagsSenseBenchmark;
 
 public:
     qCtagsSenseIndexer( qCtagsSenseSQL* parent );
@@ -42,34 +50,113 @@ public:
 
     void clear();
     QStringList filteredSuffixes() const;
+    int workers() const;
 
 public slots:
     void addFilteredSuffixes( const QStringList& suffixes );
     void addFilteredSuffix( const QString& suffix );
     void setFilteredSuffixes( const QStringList& suffixes );
     void setFilteredSuffix( const QString& suffix );
+    void setWorkers( int count );
 
     void removeFile( const QString& fileName );
     void indexFile( const QString& fileName );
     void indexFiles( const QStringList& fileNames );
+    void indexProjectFiles( const QString& path, const QStringList& fileNames );
     void indexBuffers( const QMap<QString, QString>& buffers );
 
 protected:
+    struct FileState
+    {
+        FileState()
+        {
+            size = -1;
+            modified = -1;
+        }
+        
+        bool isNull() const
+        {
+            return size == -1;
+        }
+        
+        qint64 size;
+        qint64 modified; // msecs since epoch
+        QByteArray hash; // md5 of the content as hexadecimal
+    };
+    
+    struct TaggedFile
+    {
+        TaggedFile( const QString& name = QString::null )
+        {
+            fileName = name;
+            item = 0;
+            ok = false;
+            unchanged = false;
+        }
+        
+        QString fileName;
+        TagEntryListItem* item; // null if the file was skipped, unchanged or failed
+        bool ok;
+        bool unchanged; // the file content is the indexed one
+        FileState stored; // state of the indexed file, null if not indexed
+        FileState state; // current state of the file
+    };
+
     qCtagsSenseSQL* mSQL;
     QStringList mFilteredSuffixes;
     QMap<QString, QString> mWaitingIndexation; // fileName, content
     QList<QString> mWaitingDeletion; // fileNames
+    QStringList mWaitingPruning; // paths of the projects, files missing on disk are removed
+    QHash<QString, QSet<QString> > mProjectsFiles; // path, fileNames of the indexed projects
     QMutex mMutex;
     bool mStop;
-
+    int mWorkers;
+    // tagging pipeline
+    QMutex mPipelineMutex;
+    QWaitCondition mTaggedAvailable;
+    QWaitCondition mTaggedConsumed;
+    QList<TaggedFile> mFilesToTag;
+    QList<TaggedFile> mTaggedFiles;
+    int mTaggedFilesMaximum;
+    int mRunningTaggers;
+    // bulk writing, queries are prepared once per run
+    QSqlQuery mRemoveFileQuery;
+    QSqlQuery mRemovePathQuery;
+    QSqlQuery mFileQuery;
+    QSqlQuery mTouchFileQuery;
+    QSqlQuery mEntriesQuery;
+    QSqlQuery mNamesQuery;
+    QSqlQuery mNameTrigramsQuery;
+    QList<QVariantList> mPendingEntries; // one list of values per entries column
+    int mPendingEntriesCount;
+    QSet<QString> mPendingFiles; // files having pending entries
+    QVariantList mPendingNames;
+    QVariantList mPendingTrigrams;
+    QVariantList mPendingTrigramsNames;
+    QSet<QString> mIndexedNames; // names already sent to the search tables during this run
+    bool mRemovedEntries; // entries were deleted during this run, some names may have no entries left
+
+    bool prepareQueries();
+    void releaseQueries();
+    bool flushEntries();
     bool removeEntries( const QStringList& fileNames );
-    bool indexEntry( const QString& fileName );
+    bool removeOrphanNames();
+    bool indexFileEntries( const QStringList& fileNames, int& value, int total, bool& changed, bool& error );
+    QHash<QString, FileState> storedFileStates() const;
+    QStringList indexedFileNames( const QString& path ) const;
+    bool touchFileEntry( const QString& fileName, const FileState& state );
+    bool takeFileToTag( TaggedFile& file );
+    void tagFile( TaggedFile& file );
+    void pushTaggedFile( const TaggedFile& file );
+    bool takeTaggedFile( TaggedFile& file );
+    void taggerFinished();
+    void freeParserResources();
     bool indexEntries( const QMap<QString, QString>& entries );
-    int createFileEntry( const QString& fileName, const QString& language );
+    int createFileEntry( const QString& fileName, const QString& language, const FileState& state = FileState() );
     bool createEntries( int fileId, TagEntryListItem* item );
-    bool indexTags( const QMap<QString, TagEntryListItem*>& tags );
-    TagEntryListItem* tagFileEntry( const QString& fileName, bool& ok );
-    QMap<QString, TagEntryListItem*> tagPathEntries( const QString& pathName, bool& ok );
+    bool indexTags( const QMap<QString, TagEntryListItem*>& tags, const QMap<QString, FileState>& states = QMap<QString, FileState>() );
+    bool isFilteredFile( const QString& fileName );
+    TagEntryListItem* tagBufferEntry( const QString& fileName, const QByteArray& buffer, bool& ok );
     QMap<QString, TagEntryListItem*> tagBuffersEntries( const QMap<QString, QString>& entries, bool& ok );
 
     virtual void run();
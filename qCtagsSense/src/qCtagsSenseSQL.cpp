@@ -21,6 +21,7 @@
 #include <QDir>
 #include <QStringList>
 #include <QSqlError>
+#include <QSqlRecord>
 #include <QDebug>
 
 qCtagsSenseSQL::qCtagsSenseSQL( QObject* parent )
@@ -41,14 +42,6 @@ bool qCtagsSenseSQL::initializeDatabase( const QString& fileName )
         return false;
     }
     
-    if ( QFile::exists( fileName ) )
-    {
-        if ( !QFile::remove( fileName ) )
-        {
-            return false;
-        }
-    }
-    
     QSqlDatabase db = QSqlDatabase::addDatabase( "QSQLITE", mDBConnectionName );
     
     db.setDatabaseName( fileName.isEmpty() ? ":memory:" : fileName );
@@ -60,6 +53,27 @@ bool qCtagsSenseSQL::initializeDatabase( const QString& fileName )
         return false;
     }
     
+    // physical databases are kept between sessions, recreate the ones written by an older schema
+    const QStringList tables = db.tables();
+    QSqlQuery indexes = query();
+    const bool hasIndexes = indexes.exec( "SELECT COUNT( name ) FROM sqlite_master WHERE type = 'index' AND name IN ( 'names_name_nocase', 'entries_file_id' )" )
+        && indexes.next() && indexes.value( 0 ).toInt() == 2;
+    indexes.finish();
+    
+    if ( tables.contains( "files", Qt::CaseInsensitive ) &&
+        ( !db.record( "files" ).contains( "hash" ) || !tables.contains( "name_trigrams", Qt::CaseInsensitive ) || !hasIndexes ) )
+    {
+        QSqlQuery q = query();
+        
+        foreach ( const QString& table, QStringList() << "entries" << "files" << "names" << "name_trigrams" )
+        {
+            if ( !q.exec( QString( "DROP TABLE IF EXISTS %1" ).arg( table ) ) )
+            {
+                qWarning() << "Can't drop outdated table" << table << q.lastError().text();
+            }
+        }
+    }
+    
     if ( !db.tables().contains( "files", Qt::CaseInsensitive ) )
     {
         if ( !initializeTables() )
@@ -80,7 +94,10 @@ bool qCtagsSenseSQL::initializeTables() const
         "CREATE TABLE 'main'.'files' ("
         "'id' INTEGER PRIMARY KEY AUTOINCREMENT,"
         "'fileName' TEXT NOT NULL,"
-        "'language' TEXT NOT NULL"
+        "'language' TEXT NOT NULL,"
+        "'size' INTEGER,"
+        "'mtime' INTEGER,"
+        "'hash' TEXT"
         ");"
     );
     
@@ -126,10 +143,36 @@ bool qCtagsSenseSQL::initializeTables() const
         "CREATE INDEX 'entries_name_asc' on 'entries' (name ASC)"
     );
     
+    // entries of a deleted file are found by the files trigger without scanning the table
+    const QString sql_entries_file_id = QString(
+        "CREATE INDEX 'entries_file_id' on 'entries' (file_id)"
+    );
+    
     const QString sql_entries_scope_key_asc = QString(
         "CREATE INDEX 'entries_scope_key_asc' on 'entries' (scope_key ASC)"
     );
     
+    // distinct tag names, and the lower case trigrams of each name
+    // the indexer removes the names left without entries at the end of each run
+    const QString sql_names = QString(
+        "CREATE TABLE 'main'.'names' ("
+        "'name' TEXT PRIMARY KEY"
+        ");"
+    );
+    
+    // case insensitive prefix searches of the names too short for the trigrams
+    const QString sql_names_name_nocase = QString(
+        "CREATE INDEX 'names_name_nocase' on 'names' (name COLLATE NOCASE)"
+    );
+    
+    const QString sql_name_trigrams = QString(
+        "CREATE TABLE 'main'.'name_trigrams' ("
+        "'trigram' TEXT NOT NULL,"
+        "'name' TEXT NOT NULL,"
+        "UNIQUE ( trigram, name )"
+        ");"
+    );
+    
     QSqlQuery q = query();
     
     if ( q.exec( sql_files ) )
@@ -138,35 +181,36 @@ bool qCtagsSenseSQL::initializeTables() const
         {
             if ( q.exec( sql_files_trigger ) )
             {
+                // files index is needed by the indexer to lookup stored files states
+                // entries file index is needed by the files trigger
+                // names tables are needed by the symbol search
+                const QStringList sql_search = QStringList()
+                    << sql_files_filename_asc << sql_entries_name_asc << sql_entries_file_id << sql_names << sql_names_name_nocase << sql_name_trigrams;
+                
+                foreach ( const QString& sql, sql_search )
+                {
+                    if ( !q.exec( sql ) )
+                    {
+                        qWarning() << "Can't create search tables" << q.lastError().text();
+                        return false;
+                    }
+                }
+                
                 /*
-                if ( q.exec( sql_files_filename_asc ) )
+                if ( q.exec( sql_files_language_asc ) )
                 {
-                    if ( q.exec( sql_files_language_asc ) )
+                    if ( q.exec( sql_entries_scope_key_asc ) )
                     {
-                        if ( q.exec( sql_entries_name_asc ) )
-                        {
-                            if ( q.exec( sql_entries_scope_key_asc ) )
-                            {
-                                return true;
-                            }
-                            else
-                            {
-                                qWarning() << "Can't create scope_key index" << q.lastError().text();
-                            }
-                        }
-                        else
-                        {
-                            qWarning() << "Can't create name index" << q.lastError().text();
-                        }
+                        return true;
                     }
                     else
                     {
-                        qWarning() << "Can't create language index" << q.lastError().text();
+                        qWarning() << "Can't create scope_key index" << q.lastError().text();
                     }
                 }
                 else
                 {
-                    qWarning() << "Can't create filename index" << q.lastError().text();
+                    qWarning() << "Can't create language index" << q.lastError().text();
                 }
                 */
                 
@@ -196,16 +240,9 @@ bool qCtagsSenseSQL::removeCurrentDatabase()
     if ( QSqlDatabase::contains( mDBConnectionName ) )
     {
         {
+            // physical database files are kept so next sessions only index changed files
             QSqlDatabase db = QSqlDatabase::database( mDBConnectionName );
             db.close();
-            
-            if ( QFile::exists( db.databaseName() ) )
-            {
-                if ( !QFile::remove( db.databaseName() ) )
-                {
-                    return false;
-                }
-            }
         }
         
         QSqlDatabase::removeDatabase( mDBConnectionName );
@@ -37,6 +37,7 @@ public:
         mSQL = parent;
         mStop = false;
         mRestart = false;
+        mMaximum = 0;
     }
     
     virtual ~qCtagsSenseSearchThread()
@@ -54,13 +55,16 @@ public:
     }
 
 public slots:
-    void executeQuery( const QString& sql )
+    // the queries are executed in order until maximum entries are read
+    void executeQueries( const QStringList& queries, const QString& search, int maximum )
     {
         {
             QMutexLocker locker( &mMutex );
             mRestart = isRunning();
             mStop = false;
-            mQuery = sql;
+            mQueries = queries;
+            mSearch = search;
+            mMaximum = maximum;
         }
         
         if ( !isRunning() )
@@ -73,7 +77,9 @@ protected:
     QMutex mMutex;
     qCtagsSenseSQL* mSQL;
     bool mStop;
-    QString mQuery;
+    QStringList mQueries;
+    QString mSearch;
+    int mMaximum;
     QList<SearchMapEntries*> mEntriesList;
     bool mRestart;
     
@@ -107,34 +113,55 @@ protected:
             emit searching( true );
             clearEntries();
             
-            SearchMapEntries* mEntries = new SearchMapEntries();
-            QSqlQuery q = mSQL->query();
-            q.setForwardOnly( true );
-            
-            bool ok = q.exec( mQuery );
+            // the results are given back with the search they answer
+            QStringList queries;
+            QString search;
+            int maximum;
             
-            if ( !ok )
             {
-                qWarning() << "Can't get entries for population";
+                QMutexLocker locker( &mMutex );
+                queries = mQueries;
+                search = mSearch;
+                maximum = mMaximum;
             }
             
-            while ( q.next() )
+            SearchMapEntries* mEntries = new SearchMapEntries();
+            int count = 0;
+            bool interrupted = false;
+            
+            foreach ( const QString& sql, queries )
             {
-                qCtagsSenseEntry* entry = qCtagsSenseUtils::entryForRecord( q.record(), QString::null );
-                (*mEntries)[ entry->fileName ] << entry;
+                QSqlQuery q = mSQL->query();
+                q.setForwardOnly( true );
+                
+                bool ok = q.exec( sql );
                 
+                if ( !ok )
                 {
-                    QMutexLocker locker( &mMutex );
+                    qWarning() << "Can't get entries for population";
+                }
+                
+                while ( count < maximum && q.next() )
+                {
+                    qCtagsSenseEntry* entry = qCtagsSenseUtils::entryForRecord( q.record(), QString::null );
+                    (*mEntries)[ entry->fileName ] << entry;
+                    count++;
                     
-                    if ( mStop )
                     {
-                        break;
-                    }
-                    else if ( mRestart )
-                    {
-                        break;
+                        QMutexLocker locker( &mMutex );
+                        
+                        if ( mStop || mRestart )
+                        {
+                            interrupted = true;
+                            break;
+                        }
                     }
                 }
+                
+                if ( interrupted || count >= maximum )
+                {
+                    break;
+                }
             }
             
             {
@@ -150,13 +177,13 @@ protected:
             }
             
             emit searching( false );
-            emit queryFinished( mEntries );
+            emit queryFinished( mEntries, search );
             break;
         }
     }
 
 signals:
-    void queryFinished( SearchMapEntries* entries );
+    void queryFinished( SearchMapEntries* entries, const QString& search );
     void searching( bool searching );
 };
 
@@ -166,10 +193,11 @@ qCtagsSenseSearchModel::qCtagsSenseSearchModel( qCtagsSenseSQL* parent )
     mSQL = parent;
     mEntries = 0;
     mCacheCount = 0;
+    mMaximumResults = 1000;
     mThread = new qCtagsSenseSearchThread( mSQL );
     
     connect( mThread, SIGNAL( searching( bool ) ), this, SIGNAL( searching( bool ) ) );
-    connect( mThread, SIGNAL( queryFinished( SearchMapEntries* ) ), this, SLOT( queryFinished( SearchMapEntries* ) ) );
+    connect( mThread, SIGNAL( queryFinished( SearchMapEntries*, const QString& ) ), this, SLOT( queryFinished( SearchMapEntries*, const QString& ) ) );
 }
 
 qCtagsSenseSearchModel::~qCtagsSenseSearchModel()
@@ -342,6 +370,24 @@ bool qCtagsSenseSearchModel::caseInsensitiveFileNameLessThan( const QString& s1,
     return QFileInfo( s1.toLower() ).fileName() < QFileInfo( s2.toLower() ).fileName();
 }
 
+int qCtagsSenseSearchModel::matchRank( const QString& name, const QString& search )
+{
+    if ( name == search )
+    {
+        return 0;
+    }
+    else if ( name.compare( search, Qt::CaseInsensitive ) == 0 )
+    {
+        return 1;
+    }
+    else if ( name.startsWith( search, Qt::CaseInsensitive ) )
+    {
+        return 2;
+    }
+    
+    return 3;
+}
+
 void qCtagsSenseSearchModel::clear()
 {
     beginResetModel();
@@ -355,17 +401,81 @@ void qCtagsSenseSearchModel::clear()
 
 void qCtagsSenseSearchModel::refresh( const QString& search )
 {
-    const QString sql = QString(
-        "SELECT entries.*, language, filename FROM entries "
-        "INNER JOIN files ON files.id = entries.file_id "
-        "AND entries.name LIKE '%%1%'"
-    ).arg( search );
+    const QString name = qCtagsSenseUtils::sqlEscaped( search );
+    const QString like = qCtagsSenseUtils::sqlEscaped( search, true );
+    const QStringList trigrams = qCtagsSenseUtils::trigrams( search );
+    QString names;
+    QStringList queries;
+    
+    if ( trigrams.isEmpty() )
+    {
+        // too short for the trigrams index, the names starting with the search are read in order from the prefix index first
+        QString prefix;
+        
+        if ( !search.isEmpty() )
+        {
+            QString last = search.toLower();
+            last[ last.length() -1 ] = QChar( last.at( last.length() -1 ).unicode() +1 );
+            
+            prefix = QString( "names.name COLLATE NOCASE >= '%1' AND names.name COLLATE NOCASE < '%2'" )
+                .arg( qCtagsSenseUtils::sqlEscaped( search.toLower() ), qCtagsSenseUtils::sqlEscaped( last ) );
+        }
+        
+        // case insensitive order puts the exact matches first, only the names of a same case insensitive value are sorted
+        // the cross joins keep the names as the outer loop so the rows come in the index order
+        queries << QString(
+            "SELECT entries.*, language, filename FROM names "
+            "CROSS JOIN entries ON entries.name = names.name "
+            "INNER JOIN files ON files.id = entries.file_id "
+            "%1"
+            "ORDER BY names.name COLLATE NOCASE, ( names.name = '%2' ) DESC "
+            "LIMIT %3"
+        ).arg( prefix.isEmpty() ? QString::null : QString( "WHERE %1 " ).arg( prefix ), name, QString::number( mMaximumResults ) );
+        
+        // then the other names containing the search like the trigrams search, only read if the prefixes are not enough
+        if ( !prefix.isEmpty() )
+        {
+            queries << QString(
+                "SELECT entries.*, language, filename FROM names "
+                "CROSS JOIN entries ON entries.name = names.name "
+                "INNER JOIN files ON files.id = entries.file_id "
+                "WHERE names.name LIKE '%%1%' ESCAPE '\\' AND NOT ( %2 ) "
+                "ORDER BY names.name "
+                "LIMIT %3"
+            ).arg( like, prefix, QString::number( mMaximumResults ) );
+        }
+    }
+    else
+    {
+        QStringList values;
+        
+        foreach ( const QString& trigram, trigrams )
+        {
+            values << QString( "'%1'" ).arg( qCtagsSenseUtils::sqlEscaped( trigram ) );
+        }
+        
+        names = QString(
+            "SELECT name FROM name_trigrams WHERE trigram IN ( %1 ) "
+            "GROUP BY name HAVING COUNT( trigram ) = %2"
+        ).arg( values.join( ", " ), QString::number( trigrams.count() ) );
+        
+        // best matches first: exact, exact case insensitive, prefix, shortest
+        queries << QString(
+            "SELECT entries.*, language, filename FROM entries "
+            "INNER JOIN files ON files.id = entries.file_id "
+            "WHERE entries.name IN ( %1 ) "
+            "AND entries.name LIKE '%%2%' ESCAPE '\\' "
+            "ORDER BY ( entries.name = '%3' ) DESC, ( entries.name LIKE '%2' ESCAPE '\\' ) DESC, "
+            "( entries.name LIKE '%2%' ESCAPE '\\' ) DESC, LENGTH( entries.name ), entries.name "
+            "LIMIT %4"
+        ).arg( names, like, name, QString::number( mMaximumResults ) );
+    }
     
     clear();
-    mThread->executeQuery( sql );
+    mThread->executeQueries( queries, search, mMaximumResults );
 }
 
-void qCtagsSenseSearchModel::queryFinished( SearchMapEntries* entries )
+void qCtagsSenseSearchModel::queryFinished( SearchMapEntries* entries, const QString& search )
 {
     beginResetModel();
     // get datas
@@ -375,8 +485,16 @@ void qCtagsSenseSearchModel::queryFinished( SearchMapEntries* entries )
     mCacheCount = mEntries->count();
     mCacheKeys.clear();
     
-    QStringList keys = mEntries->keys();
-    qSort( keys.begin(), keys.end(), caseInsensitiveFileNameLessThan );
+    // files having the best matches first, entries of a file are already ordered by the query
+    QMap<QString, QString> rankedKeys;
+    
+    foreach ( const QString& fileName, mEntries->keys() )
+    {
+        const int rank = matchRank( mEntries->value( fileName ).first()->name, search );
+        rankedKeys[ QString( "%1 %2" ).arg( rank ).arg( QFileInfo( fileName ).fileName().toLower() ) +fileName ] = fileName;
+    }
+    
+    const QStringList keys = rankedKeys.values();
     for ( int i = 0; i < mCacheCount; i++ )
     {
         mCacheKeys[ keys.at( i ) ] = i;
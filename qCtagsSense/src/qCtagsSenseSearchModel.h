@@ -54,6 +54,7 @@ public:
     QModelIndex index( const QString& fileName ) const;
     
     static bool caseInsensitiveFileNameLessThan( const QString& s1, const QString& s2 );
+    static int matchRank( const QString& name, const QString& search );
 
 public slots:
     void clear();
@@ -65,9 +66,10 @@ protected:
     SearchMapEntries* mEntries;
     QHash<QString, int> mCacheKeys;
     int mCacheCount;
+    int mMaximumResults;
 
 protected slots:
-    void queryFinished( SearchMapEntries* entries );
+    void queryFinished( SearchMapEntries* entries, const QString& search );
 
 signals:
     void ready();
@@ -0,0 +1,46 @@
+/****************************************************************************
+    Copyright (C) 2005 - 2011  Filipe AZEVEDO & The Monkey Studio Team
+    http://monkeystudio.org licensing under the GNU GPL.
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+****************************************************************************/
+#ifndef QCTAGSSENSETAGGER_H
+#define QCTAGSSENSETAGGER_H
+
+#include "qCtagsSenseExport.h"
+
+#include <QThread>
+
+class qCtagsSenseIndexer;
+
+/*
+    A tagging worker of the indexer pipeline.
+    It takes files to tag from the indexer, run ctags on them and hand back the tags to the indexer
+    that write them in the database.
+*/
+class QCTAGSSENSE_EXPORT qCtagsSenseTagger : public QThread
+{
+    Q_OBJECT
+
+public:
+    qCtagsSenseTagger( qCtagsSenseIndexer* indexer );
+
+protected:
+    qCtagsSenseIndexer* mIndexer;
+
+    virtual void run();
+};
+
+#endif // QCTAGSSENSETAGGER_H
@@ -632,6 +632,36 @@ QString qCtagsSenseUtils::entryToolTip( const qCtagsSenseEntry* entry )
     return tooltip;
 }
 
+QStringList qCtagsSenseUtils::trigrams( const QString& text )
+{
+    const QString lower = text.toLower();
+    QStringList result;
+    
+    for ( int i = 0; i +3 <= lower.length(); i++ )
+    {
+        const QString trigram = lower.mid( i, 3 );
+        
+        if ( !result.contains( trigram ) )
+        {
+            result << trigram;
+        }
+    }
+    
+    return result;
+}
+
+QString qCtagsSenseUtils::sqlEscaped( const QString& text, bool like )
+{
+    QString escaped = text;
+    
+    if ( like )
+    {
+        escaped.replace( "\\", "\\\\" ).replace( "%", "\\%" ).replace( "_", "\\_" );
+    }
+    
+    return escaped.replace( "'", "''" );
+}
+
 QFileInfoList qCtagsSenseUtils::getFiles( QDir fromDir, const QStringList& filters, bool recursive )
 {
     QFileInfoList files;
@@ -48,6 +48,9 @@ namespace qCtagsSenseUtils
     QCTAGSSENSE_EXPORT QString entryDisplay( const qCtagsSenseEntry* entry );
     QCTAGSSENSE_EXPORT QString entryToolTip( const qCtagsSenseEntry* entry );
     
+    QCTAGSSENSE_EXPORT QStringList trigrams( const QString& text );
+    QCTAGSSENSE_EXPORT QString sqlEscaped( const QString& text, bool like = false );
+    
     QCTAGSSENSE_EXPORT QFileInfoList getFiles( QDir fromDir, const QStringList& filters, bool recursive = true );
 };
 